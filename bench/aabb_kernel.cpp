@@ -0,0 +1,181 @@
+/* AABB kernel benchmark
+ *
+ * Tests a player rectangle against packed colliders with the scalar kernel
+ * and the vector kernel, and checks the swept collision that is built on
+ * them against testing every collider one at a time:
+ *   aabb_bench [collider count] [repetitions]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "engine/aabb_kernel.hpp"
+#include "engine/collision.hpp"
+#include "engine/world.hpp"
+
+void BuildRects(EntityStore *rects, int count, int spread, int seed);
+
+double KernelNs(const EntityStore *rects, int repetitions, bool vector);
+
+int SweepOneAtATime(SDL_Rect start, int delta, bool vertical,
+                    const std::vector<SDL_Rect> &rects,
+                    const std::vector<Uint8> &kinds);
+
+int CheckSweep(int trials);
+
+int main(int argc, char *argv[]) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int repetitions = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const int spread = 4096;  // colliders are placed in a square this wide
+
+    EntityStore rects;
+    BuildRects(&rects, count, spread, 1);
+
+    const double scalar_ns = KernelNs(&rects, repetitions, false);
+    const double vector_ns = KernelNs(&rects, repetitions, true);
+
+    std::cout << "colliders: " << count << ", repetitions: " << repetitions
+              << std::endl;
+    std::cout << "scalar kernel: " << scalar_ns << " ns per collider"
+              << std::endl;
+    std::cout << AabbKernelName() << " kernel: " << vector_ns
+              << " ns per collider, " << scalar_ns / vector_ns
+              << "x the scalar kernel" << std::endl;
+
+    const int mismatches = CheckSweep(100000);
+    std::cout << "sweep mismatches: " << mismatches << std::endl;
+
+    return mismatches == 0 ? 0 : -1;
+}
+
+void BuildRects(EntityStore *rects, int count, int spread, int seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> position(0, spread);
+    std::uniform_int_distribution<int> size(8, 48);
+
+    ClearEntities(rects);
+    for (int i = 0; i < count; i++) {
+        const SDL_Rect rect = {position(random), position(random),
+                               size(random), size(random)};
+        AddEntity(rects, rect, COLLIDER_BLOCK, 0);
+    }
+}
+
+double KernelNs(const EntityStore *rects, int repetitions, bool vector) {
+    const int count = EntityCount(rects);
+    Contacts contacts;
+    contacts.mask.resize((count + 31) / 32);
+    int found = 0;
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < repetitions; r++) {
+        const SDL_Rect player = {r % 4096, (r * 7) % 4096, 24, 24};
+
+        if (vector) {
+            found += OverlapRects(player, rects->x.data(), rects->y.data(),
+                                  rects->w.data(), rects->h.data(), count,
+                                  contacts.mask.data());
+        } else {
+            found += OverlapRectsScalar(player, rects->x.data(),
+                                        rects->y.data(), rects->w.data(),
+                                        rects->h.data(), count,
+                                        contacts.mask.data());
+        }
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    if (found == 42) {
+        std::cout << std::endl;
+    }
+
+    return static_cast<double>(end - start) * 1e9 /
+           SDL_GetPerformanceFrequency() / (1.0 * count * repetitions);
+}
+
+int SweepOneAtATime(SDL_Rect start, int delta, bool vertical,
+                    const std::vector<SDL_Rect> &rects,
+                    const std::vector<Uint8> &kinds) {
+    int distance = delta;
+
+    for (size_t i = 0; i < rects.size(); i++) {
+        const SDL_Rect &r = rects[i];
+        const bool platform = kinds[i] == COLLIDER_PLATFORM;
+
+        if (vertical && (r.x >= start.x + start.w || start.x >= r.x + r.w)) {
+            continue;
+        }
+        if (!vertical && (r.y >= start.y + start.h || start.y >= r.y + r.h)) {
+            continue;
+        }
+
+        const int near = vertical ? start.y : start.x;
+        const int far = vertical ? start.y + start.h : start.x + start.w;
+        const int r_near = vertical ? r.y : r.x;
+        const int r_far = vertical ? r.y + r.h : r.x + r.w;
+
+        if (delta > 0 && r_near >= far && r_near < far + delta &&
+            (!platform || vertical)) {
+            distance = std::min(distance, r_near - far);
+        } else if (delta < 0 && r_far <= near && r_far > near + delta &&
+                   !platform) {
+            distance = std::max(distance, r_far - near);
+        }
+    }
+
+    return distance;
+}
+
+int CheckSweep(int trials) {
+    /* Dense clusters around the player moving fast in any direction */
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> offset(-60, 60);
+    std::uniform_int_distribution<int> count(0, 40);
+    std::uniform_int_distribution<int> kind(0, 3);
+
+    TileMap tilemap;
+    InitTileMap(&tilemap, 1, 1, 24);
+
+    SpatialHash hash;
+    int mismatches = 0;
+
+    for (int trial = 0; trial < trials; trial++) {
+        InitSpatialHash(&hash, 48, 16);
+        std::vector<SDL_Rect> rects;
+        std::vector<Uint8> kinds;
+
+        const int rect_count = count(random);
+        for (int i = 0; i < rect_count; i++) {
+            const SDL_Rect rect = {200 + offset(random), 200 + offset(random),
+                                   24, 24};
+            const Uint8 collider_kind =
+                kind(random) == 0 ? COLLIDER_PLATFORM : COLLIDER_BLOCK;
+            InsertCollider(&hash, rect, collider_kind, 0);
+            rects.push_back(rect);
+            kinds.push_back(collider_kind);
+        }
+
+        Player player =
+            CreatePlayerAt(200 + offset(random), 200 + offset(random));
+        const SDL_Rect start = player.dstrect;
+        player.dstrect.x += offset(random);
+        player.dstrect.y += offset(random);
+
+        SDL_Rect expected = start;
+        expected.x += SweepOneAtATime(expected, player.dstrect.x - start.x,
+                                      false, rects, kinds);
+        expected.y += SweepOneAtATime(expected, player.dstrect.y - start.y,
+                                      true, rects, kinds);
+
+        player.dstrect = SweepRect(start, player.dstrect, &tilemap, &hash,
+                                   &hash.scratch, &player.collision_state);
+
+        if (player.dstrect.x != expected.x || player.dstrect.y != expected.y) {
+            mismatches += 1;
+        }
+    }
+
+    return mismatches;
+}
@@ -0,0 +1,176 @@
+/* Batch environment throughput
+ *
+ * Steps thousands of worlds of a level with random actions at every thread
+ * count from 1 to N and reports the simulation steps per second. Every
+ * thread count has to end in the same state, and a world stepped by the
+ * batch has to match the same world simulated on its own:
+ *   batch_bench [level] [worlds] [steps] [max threads]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "engine/actions.hpp"
+#include "engine/batch_env.hpp"
+#include "engine/replay.hpp"
+#include "engine/simulation.hpp"
+#include "engine/world.hpp"
+
+constexpr int TICK_RATE = 60;
+constexpr Uint32 EPISODE_TICKS = 3600;  // a minute of play per episode
+
+Uint64 HashStep(const std::vector<Observation> &observations,
+                const std::vector<float> &rewards,
+                const std::vector<Uint8> &dones, Uint64 hash);
+
+int main(int argc, char *argv[]) {
+    const char *level_path = argc > 1 ? argv[1] : "assets/levels/level1.lvl";
+    const int worlds = argc > 2 ? std::atoi(argv[2]) : 4096;
+    const int steps = argc > 3 ? std::atoi(argv[3]) : 1000;
+    const int hardware_threads =
+        static_cast<int>(std::thread::hardware_concurrency());
+    const int max_threads =
+        argc > 4 ? std::atoi(argv[4]) : std::max(1, hardware_threads);
+
+    Level level;
+
+    if (!LoadLevel(&level, level_path)) {
+        std::string debug_msg =
+            "LoadLevel: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    SpatialHash objects;
+    BuildColliders(&level, &objects);
+
+    /* Walk, turn around, jump and drop at random */
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> chance(0, 99);
+    std::vector<Uint8> actions(static_cast<size_t>(worlds) * steps, 0);
+
+    for (int world = 0; world < worlds; world++) {
+        Uint8 held = 0;
+
+        for (int step = 0; step < steps; step++) {
+            if (step % 45 == 0) {
+                const int roll = chance(random);
+                held = roll < 50 ? ACTION_RIGHT
+                                 : (roll < 75 ? ACTION_LEFT : 0);
+            }
+
+            const int roll = chance(random);
+            actions[static_cast<size_t>(step) * worlds + world] =
+                held | (roll < 5 ? ACTION_JUMP : 0) |
+                (roll >= 97 ? ACTION_DROP : 0);
+        }
+    }
+
+    std::cout << "worlds: " << worlds << ", steps: " << steps << std::endl;
+
+    std::vector<Observation> observations(worlds);
+    std::vector<float> rewards(worlds);
+    std::vector<Uint8> dones(worlds);
+
+    double single_ms = 0.0;
+    Uint64 expected = 0;
+    int mismatches = 0;
+
+    for (int threads = 1; threads <= max_threads; threads++) {
+        BatchEnv env;
+        InitBatchEnv(&env, &level, &objects, worlds, threads, TICK_RATE,
+                     EPISODE_TICKS);
+        ResetBatchEnv(&env, observations.data());
+
+        Uint64 checksum = 14695981039346656037ULL;
+        double ms = 0.0;
+
+        for (int step = 0; step < steps; step++) {
+            const Uint64 start = SDL_GetPerformanceCounter();
+            StepBatchEnv(&env, &actions[static_cast<size_t>(step) * worlds],
+                         observations.data(), rewards.data(), dones.data());
+            const Uint64 end = SDL_GetPerformanceCounter();
+
+            ms += static_cast<double>(end - start) * 1000.0 /
+                  SDL_GetPerformanceFrequency();
+            checksum = HashStep(observations, rewards, dones, checksum);
+        }
+
+        if (threads == 1) {
+            single_ms = ms;
+            expected = checksum;
+        } else if (checksum != expected) {
+            mismatches += 1;
+        }
+
+        const double steps_per_second =
+            static_cast<double>(worlds) * steps * 1000.0 / std::max(ms, 1e-9);
+
+        std::cout << "threads: " << threads << ", " << steps_per_second
+                  << " steps per second, " << single_ms / ms << "x speedup, "
+                  << env.jobs.steals.load() << " steals, checksum " << std::hex
+                  << checksum << std::dec << std::endl;
+
+        FreeBatchEnv(&env);
+    }
+
+    /* The first world simulated on its own */
+    BatchEnv env;
+    InitBatchEnv(&env, &level, &objects, worlds, 1, TICK_RATE, EPISODE_TICKS);
+
+    Player player = CreatePlayer(&level);
+    Uint32 episode_tick = 0;
+
+    for (int step = 0; step < steps; step++) {
+        StepBatchEnv(&env, &actions[static_cast<size_t>(step) * worlds],
+                     observations.data(), rewards.data(), dones.data());
+
+        SimulateTick(&player, actions[static_cast<size_t>(step) * worlds],
+                     &level, &objects, TICK_RATE, NULL);
+        episode_tick += 1;
+
+        if (player.dstrect.x + player.dstrect.w >= level.width ||
+            episode_tick >= EPISODE_TICKS) {
+            player = CreatePlayer(&level);
+            episode_tick = 0;
+        }
+    }
+
+    const Uint64 hash = HashPlayerState(&env.players[0]);
+    const Uint64 alone_hash = HashPlayerState(&player);
+    FreeBatchEnv(&env);
+
+    std::cout << "checksum mismatches: " << mismatches
+              << ", first world state hash: " << std::hex << hash
+              << ", simulated alone " << alone_hash << std::dec << std::endl;
+
+    FreeLevel(&level);
+
+    return mismatches == 0 && hash == alone_hash ? 0 : -1;
+}
+
+Uint64 HashStep(const std::vector<Observation> &observations,
+                const std::vector<float> &rewards,
+                const std::vector<Uint8> &dones, Uint64 hash) {
+    /* FNV-1a over what the step returned */
+    for (size_t i = 0; i < observations.size(); i++) {
+        const Observation &observation = observations[i];
+        const Sint32 values[] = {observation.x,
+                                 observation.y,
+                                 observation.vx,
+                                 observation.vy,
+                                 static_cast<Sint32>(observation.flags),
+                                 static_cast<Sint32>(rewards[i]),
+                                 dones[i]};
+
+        for (Sint32 value : values) {
+            hash = (hash ^ static_cast<Uint32>(value)) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
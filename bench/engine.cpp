@@ -0,0 +1,402 @@
+/* Engine benchmarks
+ *
+ * Times the player collisions against blocks, platforms and objects off the
+ * tile grid, the physics step, and the frame of the game on the SDL software
+ * renderer over generated levels of 10 to 100k colliders, and writes the
+ * results as JSON for tracking regressions:
+ *   engine_bench [--out FILE] [--min-ms N]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "engine/aabb_kernel.hpp"
+#include "engine/camera.hpp"
+#include "engine/collision.hpp"
+#include "engine/physics.hpp"
+#include "engine/world.hpp"
+#include "render/atlas.hpp"
+#include "render/scene.hpp"
+#include "render/sprite_batch.hpp"
+#include "render/static_layer.hpp"
+
+// Runs count operations of a benchmark
+typedef void (*BenchFunction)(void *data, Uint64 count);
+
+typedef struct BenchResult {
+    std::string name;   // benchmark name
+    int colliders;      // colliders in the level, 0 when there is no level
+    Uint64 iterations;  // operations timed
+    double ns_per_op;   // mean time of one operation
+} BenchResult;
+
+typedef struct BenchLevel {
+    TileMap tilemap;              // tiles of the level
+    SpatialHash objects;          // colliders off the tile grid
+    int width;                    // width of the level in pixels
+    int height;                   // height of the level in pixels
+    std::vector<SDL_Rect> moves;  // start and target of each sweep
+    Player player;
+    Uint64 next;  // next move
+} BenchLevel;
+
+// Colliders a generated level is made of, one type per level
+enum BenchScene { BENCH_BLOCKS, BENCH_PLATFORMS, BENCH_OBJECTS };
+
+typedef struct RenderBench {
+    const BenchLevel *level;
+    SDL_Surface *surface;  // pixels the software renderer draws into
+    SDL_Renderer *rend;
+    TextureAtlas atlas;
+    SDL_Texture *background_tex;
+    EntityStore sprites;          // blocks and platforms of the area
+    std::vector<int> candidates;  // objects around the area
+    SpriteBatch tiles;
+    StaticLayer layer;
+    Camera camera;
+    Player player;
+    bool rebuild;  // build the sprites and tiles again every frame
+} RenderBench;
+
+constexpr int TILE_SIZE = 24;
+constexpr int VIEW_WIDTH = 744;
+constexpr int VIEW_HEIGHT = 504;
+constexpr int MOVE_COUNT = 1024;  // sweeps cycled through by a benchmark
+
+const int COLLIDER_COUNTS[] = {10, 100, 1000, 10000, 100000};
+
+void BuildBenchLevel(BenchLevel *level, int colliders, BenchScene scene,
+                     int seed);
+
+BenchResult RunBenchmark(const char *name, int colliders, BenchFunction run,
+                         void *data, double min_ms);
+
+void SweepBench(void *data, Uint64 count);
+
+void PhysicsBench(void *data, Uint64 count);
+
+bool InitRenderBench(RenderBench *bench, const BenchLevel *level);
+
+void RenderBenchFrames(void *data, Uint64 count);
+
+void FreeRenderBench(RenderBench *bench);
+
+void WriteResults(std::ostream &out, const std::vector<BenchResult> &results);
+
+int main(int argc, char *argv[]) {
+    const char *out_path = NULL;
+    double min_ms = 200.0;  // minimum time of each benchmark
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--out FILE] [--min-ms N]"
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+
+    /* Collisions */
+    // Each level only holds the collider type the benchmark is named after
+    for (int colliders : COLLIDER_COUNTS) {
+        BenchLevel blocks;
+        BuildBenchLevel(&blocks, colliders, BENCH_BLOCKS, 1);
+        results.push_back(RunBenchmark("PlayerBlockCollision", colliders,
+                                       SweepBench, &blocks, min_ms));
+
+        BenchLevel platforms;
+        BuildBenchLevel(&platforms, colliders, BENCH_PLATFORMS, 2);
+        results.push_back(RunBenchmark("PlayerPlatformCollision", colliders,
+                                       SweepBench, &platforms, min_ms));
+
+        BenchLevel objects;
+        BuildBenchLevel(&objects, colliders, BENCH_OBJECTS, 3);
+        results.push_back(RunBenchmark("PlayerObjectCollision", colliders,
+                                       SweepBench, &objects, min_ms));
+    }
+
+    /* Physics */
+    Player player = CreatePlayerAt(0, 0);
+    results.push_back(
+        RunBenchmark("Gravity/JumpPhysics", 0, PhysicsBench, &player, min_ms));
+
+    /* Rendering */
+    for (int colliders : COLLIDER_COUNTS) {
+        BenchLevel level;
+        BuildBenchLevel(&level, colliders, BENCH_BLOCKS, 4);
+
+        RenderBench bench;
+        if (!InitRenderBench(&bench, &level)) {
+            std::cerr << "InitRenderBench: " << SDL_GetError() << std::endl;
+            return -1;
+        }
+
+        bench.rebuild = false;
+        results.push_back(RunBenchmark("RenderSprites", colliders,
+                                       RenderBenchFrames, &bench, min_ms));
+
+        bench.rebuild = true;
+        results.push_back(RunBenchmark("RenderSprites/rebuild", colliders,
+                                       RenderBenchFrames, &bench, min_ms));
+
+        FreeRenderBench(&bench);
+    }
+
+    /* Results */
+    if (out_path == NULL) {
+        WriteResults(std::cout, results);
+        return 0;
+    }
+
+    std::ofstream file(out_path);
+    WriteResults(file, results);
+
+    if (!file) {
+        std::cerr << "engine_bench: couldn't write " << out_path << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+void BuildBenchLevel(BenchLevel *level, int colliders, BenchScene scene,
+                     int seed) {
+    std::mt19937 random(seed);
+    const bool objects = scene == BENCH_OBJECTS;
+    const Uint8 tile_kind = scene == BENCH_BLOCKS ? TILE_BLOCK : TILE_PLATFORM;
+
+    /* Level a quarter full of colliders */
+    const int side = std::max(
+        VIEW_WIDTH / TILE_SIZE,
+        static_cast<int>(std::ceil(std::sqrt(4.0 * colliders))));
+    level->width = side * TILE_SIZE;
+    level->height = side * TILE_SIZE;
+
+    std::uniform_int_distribution<int> cell(0, side - 1);
+    std::uniform_int_distribution<int> position(0, level->width - TILE_SIZE);
+
+    InitTileMap(&level->tilemap, objects ? 1 : side, objects ? 1 : side,
+                TILE_SIZE);
+    InitSpatialHash(&level->objects, 2 * TILE_SIZE,
+                    objects ? 2 * colliders : 1);
+
+    for (int placed = 0; placed < colliders;) {
+        // Objects are blocks, so only the broadphase differs from the tiles
+        if (objects) {
+            const SDL_Rect rect = {position(random), position(random),
+                                   TILE_SIZE, TILE_SIZE};
+            InsertCollider(&level->objects, rect, COLLIDER_BLOCK,
+                           SPRITE_BLOCK);
+            placed += 1;
+            continue;
+        }
+
+        const int column = cell(random);
+        const int row = cell(random);
+
+        if (GetTile(&level->tilemap, column, row) == TILE_EMPTY) {
+            SetTile(&level->tilemap, column, row, tile_kind);
+            placed += 1;
+        }
+    }
+    MergeTileColliders(&level->tilemap);
+
+    /* Sweeps of a falling, walking player */
+    std::uniform_int_distribution<int> walk(-2, 2);
+    std::uniform_int_distribution<int> fall(-8, 8);
+
+    level->moves.clear();
+    for (int i = 0; i < MOVE_COUNT; i++) {
+        const SDL_Rect start = {position(random), position(random), 24, 24};
+        const SDL_Rect target = {start.x + walk(random), start.y + fall(random),
+                                 24, 24};
+        level->moves.push_back(start);
+        level->moves.push_back(target);
+    }
+
+    level->player = CreatePlayerAt(0, 0);
+    level->next = 0;
+}
+
+BenchResult RunBenchmark(const char *name, int colliders, BenchFunction run,
+                         void *data, double min_ms) {
+    /* Double the operations until the run is long enough to time */
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 count = 1;
+    double ms = 0.0;
+
+    for (;;) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        run(data, count);
+        const Uint64 end = SDL_GetPerformanceCounter();
+
+        ms = static_cast<double>(end - start) * 1000.0 / frequency;
+        if (ms >= min_ms || count >= (1ULL << 40)) {
+            break;
+        }
+        count *= 2;
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.colliders = colliders;
+    result.iterations = count;
+    result.ns_per_op = ms * 1e6 / static_cast<double>(count);
+
+    std::cerr << name << "/" << colliders << ": " << result.ns_per_op
+              << " ns" << std::endl;
+
+    return result;
+}
+
+void SweepBench(void *data, Uint64 count) {
+    BenchLevel *level = static_cast<BenchLevel *>(data);
+    Player *player = &level->player;
+
+    for (Uint64 i = 0; i < count; i++) {
+        const size_t move = 2 * (level->next++ % MOVE_COUNT);
+        const SDL_Rect start = level->moves[move];
+
+        player->dstrect = SweepRect(start, level->moves[move + 1],
+                                    &level->tilemap, &level->objects,
+                                    &level->objects.scratch,
+                                    &player->collision_state);
+    }
+}
+
+void PhysicsBench(void *data, Uint64 count) {
+    Player *player = static_cast<Player *>(data);
+
+    for (Uint64 i = 0; i < count; i++) {
+        // Jump every half second of ticks and land where the jump started
+        if (i % 30 == 0) {
+            player->motion_state.jump = true;
+            player->body.y = 0;
+            player->body.vy = 0;
+        }
+
+        JumpPhysics(player, &player->motion_state);
+        Gravity(player, 60);
+        HorizontalMotion(player, 60);
+    }
+}
+
+bool InitRenderBench(RenderBench *bench, const BenchLevel *level) {
+    bench->level = level;
+    bench->surface = SDL_CreateRGBSurfaceWithFormat(
+        0, VIEW_WIDTH, VIEW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (bench->surface == NULL) {
+        return false;
+    }
+
+    bench->rend = SDL_CreateSoftwareRenderer(bench->surface);
+    if (bench->rend == NULL) {
+        return false;
+    }
+    SDL_SetRenderDrawColor(bench->rend, 134, 191, 255, 255);
+
+    /* Plain colored sprites in place of the images */
+    const Uint32 colors[SPRITE_COUNT] = {0xFFE04040, 0xFF806040, 0xFF40A040};
+    SDL_Surface *surfaces[SPRITE_COUNT];
+
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        surfaces[i] = SDL_CreateRGBSurfaceWithFormat(
+            0, TILE_SIZE, TILE_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_FillRect(surfaces[i], NULL, colors[i]);
+    }
+
+    const bool built =
+        BuildAtlas(bench->rend, surfaces, SPRITE_COUNT, &bench->atlas);
+    bench->background_tex =
+        SDL_CreateTextureFromSurface(bench->rend, surfaces[0]);
+
+    for (SDL_Surface *surface : surfaces) {
+        SDL_FreeSurface(surface);
+    }
+
+    if (!built || bench->background_tex == NULL) {
+        return false;
+    }
+
+    Background background;
+    background.texture = bench->background_tex;
+    background.srcrect = SDL_Rect{0, 0, TILE_SIZE, TILE_SIZE};
+    background.dstrect = SDL_Rect{0, 0, level->width, level->height};
+
+    /* View in the middle of the level */
+    bench->player = CreatePlayerAt(level->width / 2, level->height / 2);
+    bench->player.texture = bench->atlas.texture;
+    bench->player.srcrect = bench->atlas.regions[SPRITE_PLAYER];
+
+    InitCamera(&bench->camera, VIEW_WIDTH, VIEW_HEIGHT, level->width,
+               level->height);
+    FollowCamera(&bench->camera, bench->player.dstrect);
+
+    InitStaticLayer(&bench->layer, bench->rend, VIEW_WIDTH, VIEW_HEIGHT,
+                    8 * TILE_SIZE, background, bench->atlas.texture,
+                    &bench->tiles);
+    MoveStaticLayer(&bench->layer, bench->camera.view);
+
+    BuildSprites(&level->tilemap, &level->objects, bench->layer.area,
+                 &bench->candidates, &bench->sprites);
+    BuildTileBatch(&bench->tiles, &bench->atlas, &bench->sprites,
+                   bench->layer.area);
+
+    return true;
+}
+
+void RenderBenchFrames(void *data, Uint64 count) {
+    RenderBench *bench = static_cast<RenderBench *>(data);
+
+    /* The frame of the game */
+    // A rebuild is the frame the view leaves the cached area in
+    for (Uint64 i = 0; i < count; i++) {
+        if (bench->rebuild) {
+            const SDL_Rect area = bench->layer.area;
+            BuildSprites(&bench->level->tilemap, &bench->level->objects, area,
+                         &bench->candidates, &bench->sprites);
+            BuildTileBatch(&bench->tiles, &bench->atlas, &bench->sprites,
+                           area);
+            InvalidateStaticLayer(&bench->layer);
+        }
+
+        RenderSprites(bench->rend, bench->player, &bench->camera,
+                      &bench->layer, NULL, NULL);
+    }
+}
+
+void FreeRenderBench(RenderBench *bench) {
+    FreeStaticLayer(&bench->layer);
+    FreeAtlas(&bench->atlas);
+    SDL_DestroyTexture(bench->background_tex);
+    SDL_DestroyRenderer(bench->rend);
+    SDL_FreeSurface(bench->surface);
+}
+
+void WriteResults(std::ostream &out, const std::vector<BenchResult> &results) {
+    out << "{\n  \"kernel\": \"" << AabbKernelName()
+        << "\",\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name
+            << "\", \"colliders\": " << result.colliders
+            << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.ns_per_op << "}";
+    }
+
+    out << "\n  ]\n}\n";
+}
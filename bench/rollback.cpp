@@ -0,0 +1,204 @@
+/* Rollback over a loopback connection
+ *
+ * Simulates a level with the player's actions arriving a few ticks late, as
+ * they would from a remote peer. Ticks are simulated with predicted actions
+ * and simulated again from the first wrong prediction once the real actions
+ * arrive. The final state has to match a run that had every action on time:
+ *   rollback_bench [level] [delay in ticks] [ticks]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "engine/actions.hpp"
+#include "engine/replay.hpp"
+#include "engine/simulation.hpp"
+#include "engine/world.hpp"
+
+typedef struct Packet {
+    Uint32 tick;     // tick the actions belong to
+    Uint8 actions;   // actions of the tick
+    Uint32 arrival;  // tick the packet is received at
+} Packet;
+
+// Stand-in for a network connection that delivers after a fixed delay
+typedef struct LoopbackChannel {
+    std::deque<Packet> in_flight;  // packets sent and not received yet
+    int delay;                     // ticks between sending and receiving
+} LoopbackChannel;
+
+constexpr int TICK_RATE = 60;
+constexpr int RING_CAPACITY = 256;  // ticks that can be rolled back
+
+std::vector<Uint8> GenerateActions(int ticks, int seed);
+
+void SendActions(LoopbackChannel *channel, Uint32 tick, Uint8 actions);
+
+bool ReceiveActions(LoopbackChannel *channel, Uint32 now, Packet *packet);
+
+double SnapshotNs(Player *player, int repetitions);
+
+int main(int argc, char *argv[]) {
+    const char *level_path = argc > 1 ? argv[1] : "assets/levels/level1.lvl";
+    const int delay = argc > 2 ? std::atoi(argv[2]) : 8;
+    const int ticks = argc > 3 ? std::atoi(argv[3]) : 36000;
+
+    if (delay < 0 || delay >= RING_CAPACITY) {
+        std::cerr << "rollback_bench: the delay has to be below "
+                  << RING_CAPACITY << " ticks" << std::endl;
+        return -1;
+    }
+
+    Level level;
+
+    if (!LoadLevel(&level, level_path)) {
+        std::string debug_msg =
+            "LoadLevel: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    SpatialHash objects;
+    BuildColliders(&level, &objects);
+
+    const std::vector<Uint8> actions = GenerateActions(ticks, 1);
+
+    /* Every action on time */
+    Player expected = CreatePlayer(&level);
+
+    for (int tick = 0; tick < ticks; tick++) {
+        SimulateTick(&expected, actions[tick], &level, &objects, TICK_RATE,
+                     NULL);
+    }
+
+    /* Actions delayed, predicted and corrected */
+    Player player = CreatePlayer(&level);
+    SnapshotRing ring;
+    InitSnapshotRing(&ring, RING_CAPACITY, 0);
+
+    LoopbackChannel channel;
+    channel.delay = delay;
+
+    Uint8 held = 0;                           // held actions received last
+    std::vector<Uint8> received(ticks, 0);    // actions that arrived
+    std::vector<bool> arrived(ticks, false);  // whether they arrived
+    int rollbacks = 0;
+    long resimulated = 0;
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    for (int tick = 0; tick <= ticks + delay; tick++) {
+        if (tick < ticks) {
+            SendActions(&channel, tick, actions[tick]);
+        }
+
+        // Correct the ticks that were simulated with a wrong prediction
+        Packet packet;
+        Uint32 first_wrong = ring.next;
+
+        while (ReceiveActions(&channel, tick, &packet)) {
+            received[packet.tick] = packet.actions;
+            arrived[packet.tick] = true;
+
+            if (HasTick(&ring, packet.tick) &&
+                TickActions(&ring, packet.tick) != packet.actions) {
+                SetTickActions(&ring, packet.tick, packet.actions);
+                first_wrong = std::min(first_wrong, packet.tick);
+            }
+            held = packet.actions & (ACTION_LEFT | ACTION_RIGHT);
+        }
+
+        if (first_wrong != ring.next) {
+            resimulated += ring.next - first_wrong;
+            rollbacks += 1;
+            ResimulateFromTick(&ring, first_wrong, &player, &level, &objects,
+                               TICK_RATE);
+        }
+
+        // Without the actions of the tick, keep walking the way the player
+        // last walked, presses can't be predicted
+        if (tick < ticks) {
+            const Uint8 tick_actions = arrived[tick] ? received[tick] : held;
+            PushTick(&ring, &player, tick_actions);
+            SimulateTick(&player, tick_actions, &level, &objects, TICK_RATE,
+                         NULL);
+        }
+    }
+
+    const Uint64 end = SDL_GetPerformanceCounter();
+    const double ms = static_cast<double>(end - start) * 1000.0 /
+                      SDL_GetPerformanceFrequency();
+
+    const Uint64 expected_hash = HashPlayerState(&expected);
+    const Uint64 hash = HashPlayerState(&player);
+
+    std::cout << "ticks: " << ticks << ", delay: " << delay << " ticks"
+              << std::endl;
+    std::cout << "rollbacks: " << rollbacks << ", ticks simulated again: "
+              << resimulated << ", " << ms << " ms in total" << std::endl;
+    std::cout << "snapshot save and restore: " << SnapshotNs(&player, 1000000)
+              << " ns" << std::endl;
+    std::cout << "player state hash: " << std::hex << hash << ", expected "
+              << expected_hash << std::dec << std::endl;
+
+    FreeLevel(&level);
+
+    return hash == expected_hash ? 0 : -1;
+}
+
+std::vector<Uint8> GenerateActions(int ticks, int seed) {
+    /* Walk, turn around, jump and drop at random */
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> chance(0, 99);
+    std::vector<Uint8> actions(ticks, 0);
+    Uint8 held = 0;
+
+    for (int tick = 0; tick < ticks; tick++) {
+        if (tick % 45 == 0) {
+            const int roll = chance(random);
+            held = roll < 33 ? 0 : (roll < 66 ? ACTION_LEFT : ACTION_RIGHT);
+        }
+
+        const int roll = chance(random);
+        actions[tick] = held | (roll < 3 ? ACTION_JUMP : 0) |
+                        (roll >= 97 ? ACTION_DROP : 0);
+    }
+
+    return actions;
+}
+
+void SendActions(LoopbackChannel *channel, Uint32 tick, Uint8 actions) {
+    const Packet packet = {tick, actions,
+                           tick + static_cast<Uint32>(channel->delay)};
+    channel->in_flight.push_back(packet);
+}
+
+bool ReceiveActions(LoopbackChannel *channel, Uint32 now, Packet *packet) {
+    if (channel->in_flight.empty() ||
+        channel->in_flight.front().arrival > now) {
+        return false;
+    }
+
+    *packet = channel->in_flight.front();
+    channel->in_flight.pop_front();
+    return true;
+}
+
+double SnapshotNs(Player *player, int repetitions) {
+    WorldSnapshot snapshots[2];
+    SaveSnapshot(player, &snapshots[1]);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < repetitions; i++) {
+        SaveSnapshot(player, &snapshots[i & 1]);
+        RestoreSnapshot(player, &snapshots[(i + 1) & 1]);
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    return static_cast<double>(end - start) * 1e9 /
+           SDL_GetPerformanceFrequency() / repetitions;
+}
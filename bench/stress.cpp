@@ -0,0 +1,182 @@
+/* Dynamic body stress scene
+ *
+ * Walks thousands of bodies through a generated level with the job system
+ * at every thread count from 1 to N, reports how the update scales and
+ * checks that every thread count ends in the same state:
+ *   stress_bench [body count] [ticks] [max threads]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "engine/bodies.hpp"
+#include "engine/job_system.hpp"
+#include "engine/physics.hpp"
+
+typedef struct StressScene {
+    TileMap tilemap;                    // walls, floors and platforms
+    SpatialHash objects;                // colliders off the tile grid
+    BodyStore bodies;                   // bodies being updated
+    std::vector<QueryScratch> scratch;  // sweep buffers per worker
+    int tick_rate;
+} StressScene;
+
+constexpr int TILE_SIZE = 24;
+constexpr int BODY_GRAIN = 128;  // bodies per job
+
+void BuildScene(StressScene *scene, int body_count, int seed);
+
+void UpdateJob(void *data, int begin, int end, int worker);
+
+Uint64 HashBodies(const BodyStore *bodies);
+
+int main(int argc, char *argv[]) {
+    const int body_count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int ticks = argc > 2 ? std::atoi(argv[2]) : 600;
+    const int hardware_threads =
+        static_cast<int>(std::thread::hardware_concurrency());
+    const int max_threads =
+        argc > 3 ? std::atoi(argv[3]) : std::max(1, hardware_threads);
+
+    StressScene scene;
+    BuildScene(&scene, body_count, 1);
+    const BodyStore initial = scene.bodies;
+
+    std::cout << "bodies: " << body_count << ", ticks: " << ticks
+              << ", level: " << scene.tilemap.columns << "x"
+              << scene.tilemap.rows << " tiles" << std::endl;
+
+    double single_ms = 0.0;
+    Uint64 expected = 0;
+    int mismatches = 0;
+
+    for (int threads = 1; threads <= max_threads; threads++) {
+        JobSystem jobs;
+        InitJobSystem(&jobs, threads);
+
+        scene.bodies = initial;
+        scene.scratch.assign(threads, QueryScratch());
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (int tick = 0; tick < ticks; tick++) {
+            ParallelFor(&jobs, BodyCount(&scene.bodies), BODY_GRAIN,
+                        UpdateJob, &scene);
+        }
+        const Uint64 end = SDL_GetPerformanceCounter();
+
+        const double ms = static_cast<double>(end - start) * 1000.0 /
+                          SDL_GetPerformanceFrequency() / std::max(1, ticks);
+        const Uint64 checksum = HashBodies(&scene.bodies);
+
+        if (threads == 1) {
+            single_ms = ms;
+            expected = checksum;
+        } else if (checksum != expected) {
+            mismatches += 1;
+        }
+
+        std::cout << "threads: " << threads << ", " << ms << " ms per tick, "
+                  << single_ms / ms << "x speedup, " << jobs.steals.load()
+                  << " steals, checksum " << std::hex << checksum << std::dec
+                  << std::endl;
+
+        FreeJobSystem(&jobs);
+    }
+
+    std::cout << "checksum mismatches: " << mismatches << std::endl;
+
+    return mismatches == 0 ? 0 : -1;
+}
+
+void BuildScene(StressScene *scene, int body_count, int seed) {
+    std::mt19937 random(seed);
+
+    /* Level */
+    // Floors with gaps stacked above each other and walls on top of them,
+    // so bodies fall, land, jump over walls and turn around
+    const int columns = 512;
+    const int rows = 96;
+    TileMap *tilemap = &scene->tilemap;
+    InitTileMap(tilemap, columns, rows, TILE_SIZE);
+
+    for (int column = 0; column < columns; column++) {
+        SetTile(tilemap, column, rows - 1, TILE_BLOCK);
+    }
+    for (int row = 0; row < rows; row++) {
+        SetTile(tilemap, 0, row, TILE_BLOCK);
+        SetTile(tilemap, columns - 1, row, TILE_BLOCK);
+    }
+
+    std::uniform_int_distribution<int> chance(0, 99);
+    for (int row = 8; row < rows - 1; row += 8) {
+        for (int column = 1; column < columns - 1; column++) {
+            const int roll = chance(random);
+
+            if (roll < 10) {
+                continue;  // gap
+            }
+            SetTile(tilemap, column, row,
+                    roll < 30 ? TILE_PLATFORM : TILE_BLOCK);
+
+            if (roll >= 97) {
+                SetTile(tilemap, column, row - 1, TILE_BLOCK);
+            }
+        }
+    }
+    MergeTileColliders(tilemap);
+
+    /* Colliders off the grid */
+    InitSpatialHash(&scene->objects, 4 * TILE_SIZE, 1024);
+    std::uniform_int_distribution<int> object_x(TILE_SIZE,
+                                                (columns - 2) * TILE_SIZE);
+    std::uniform_int_distribution<int> object_y(TILE_SIZE,
+                                                (rows - 2) * TILE_SIZE);
+
+    for (int i = 0; i < 2000; i++) {
+        const SDL_Rect rect = {object_x(random), object_y(random), TILE_SIZE,
+                               TILE_SIZE / 2};
+        InsertCollider(&scene->objects, rect, COLLIDER_PLATFORM, 0);
+    }
+
+    /* Bodies */
+    std::uniform_int_distribution<int> column(1, columns - 2);
+    std::uniform_int_distribution<int> row(0, rows / 8 - 1);
+    std::uniform_int_distribution<int> speed(30, 120);
+
+    ClearBodies(&scene->bodies);
+    for (int i = 0; i < body_count; i++) {
+        const SDL_Rect rect = {column(random) * TILE_SIZE,
+                               (row(random) * 8 + 2) * TILE_SIZE, 16, 16};
+        const int direction = chance(random) < 50 ? -1 : 1;
+        AddBody(&scene->bodies, rect, direction * speed(random));
+    }
+
+    scene->tick_rate = 60;
+}
+
+void UpdateJob(void *data, int begin, int end, int worker) {
+    StressScene *scene = static_cast<StressScene *>(data);
+
+    UpdateBodies(&scene->bodies, begin, end, &scene->tilemap, &scene->objects,
+                 &scene->scratch[worker], scene->tick_rate);
+}
+
+Uint64 HashBodies(const BodyStore *bodies) {
+    /* FNV-1a over the state of every body */
+    Uint64 hash = 14695981039346656037ULL;
+
+    for (int i = 0; i < BodyCount(bodies); i++) {
+        const Sint32 values[] = {bodies->x[i], bodies->y[i], bodies->vx[i],
+                                 bodies->vy[i]};
+
+        for (Sint32 value : values) {
+            hash = (hash ^ static_cast<Uint32>(value)) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
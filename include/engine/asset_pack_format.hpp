@@ -0,0 +1,46 @@
+#ifndef ASSET_PACK_FORMAT_HPP
+#define ASSET_PACK_FORMAT_HPP
+
+#include <cstdint>
+
+/* Asset pack format
+ *
+ * PackHeader
+ * PackEntry entries[entry_count]
+ * asset data, every asset starts on a PACK_ALIGNMENT byte boundary
+ *
+ * Images are stored as uncompressed pixels in the pixel format of the entry,
+ * already scaled to the size they are drawn at. Other files are stored as is.
+ * All fields are little endian.
+ */
+
+constexpr char PACK_MAGIC[4] = {'P', 'A', 'K', '1'};
+constexpr std::uint32_t PACK_VERSION = 1;
+constexpr std::uint64_t PACK_ALIGNMENT = 16;
+constexpr int PACK_NAME_SIZE = 32;
+
+enum PackEntryKind { PACK_ENTRY_IMAGE = 0, PACK_ENTRY_FILE = 1 };
+
+typedef struct PackHeader {
+    char magic[4];              // PACK_MAGIC
+    std::uint32_t version;      // PACK_VERSION
+    std::uint32_t entry_count;  // amount of entries after the header
+    std::uint32_t reserved;     // zero
+} PackHeader;
+
+typedef struct PackEntry {
+    char name[PACK_NAME_SIZE];  // null terminated name of the asset
+    std::uint32_t kind;         // PackEntryKind
+    std::uint32_t format;       // SDL pixel format of an image
+    std::int32_t width;         // width of an image in pixels
+    std::int32_t height;        // height of an image in pixels
+    std::int32_t pitch;         // bytes per row of an image
+    std::uint32_t reserved;     // zero
+    std::uint64_t offset;       // start of the data from the start of the file
+    std::uint64_t size;         // size of the data in bytes
+} PackEntry;
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader must be packed");
+static_assert(sizeof(PackEntry) == 72, "PackEntry must be packed");
+
+#endif  // ASSET_PACK_FORMAT_HPP
@@ -7,32 +7,30 @@ typedef struct CollisionState {
 } CollisionState;
 
 typedef struct MotionState {
-    bool jump;
-    int jump_frames;
+    bool jump;  // a jump starts on the next tick
+    bool drop;  // dropping down from a platform on the next tick
 } MotionState;
 
+// Position and velocity in fixed-point, 1/256 of a pixel
+typedef struct PhysicsBody {
+    Sint32 x;       // left edge
+    Sint32 y;       // top edge
+    Sint32 vx;      // horizontal velocity per second
+    Sint32 vy;      // vertical velocity per second
+    Sint32 x_rest;  // horizontal motion left over from the ticks, per second
+} PhysicsBody;
+
 typedef struct Player {
     SDL_Texture *texture;  // player texture
-    int speed;             // horizontal and vertical velocity
-    int accel;             // horizonatal acceleration
+    int speed;             // horizontal velocity in pixels per second
+    int jump_speed;        // upward velocity of a jump in pixels per second
     SDL_Rect srcrect;      // player source from the player spritesheet
-    SDL_Rect dstrect;      // player destination
+    SDL_Rect dstrect;      // player destination, the body in whole pixels
+    PhysicsBody body;      // sub-pixel state the physics integrates
     CollisionState collision_state;
     MotionState motion_state;
 } Player;
 
-typedef struct Block {
-    SDL_Texture *texture;  // player texture
-    SDL_Rect srcrect;      // player source from the player spritesheet
-    SDL_Rect dstrect;      // player destination
-} Block;
-
-typedef struct Platform {
-    SDL_Texture *texture;  // player texture
-    SDL_Rect srcrect;      // player source from the player spritesheet
-    SDL_Rect dstrect;      // player destination
-} Platform;
-
 typedef struct Background {
     SDL_Texture *texture;  // player texture
     SDL_Rect srcrect;      // player source from the player spritesheet
@@ -0,0 +1,49 @@
+#ifndef LEVEL_FORMAT_HPP
+#define LEVEL_FORMAT_HPP
+
+#include <cstdint>
+
+/* Binary level format
+ *
+ * LevelHeader
+ * std::uint8_t cells[columns * rows]  tile kinds in row major order
+ * padding up to a multiple of 4 bytes
+ * LevelObject objects[object_count]   objects placed off the tile grid
+ *
+ * All fields are little endian. The loader maps the file into memory and
+ * reads the cells and objects in place.
+ */
+
+constexpr char LEVEL_MAGIC[4] = {'L', 'V', 'L', '1'};
+constexpr std::uint32_t LEVEL_VERSION = 1;
+
+enum LevelObjectKind { LEVEL_OBJECT_BLOCK = 0, LEVEL_OBJECT_PLATFORM = 1 };
+
+typedef struct LevelHeader {
+    char magic[4];               // LEVEL_MAGIC
+    std::uint32_t version;       // LEVEL_VERSION
+    std::int32_t tile_size;      // width and height of a tile in pixels
+    std::int32_t columns;        // amount of tiles per row
+    std::int32_t rows;           // amount of tiles per column
+    std::int32_t spawn_x;        // player spawn position in pixels
+    std::int32_t spawn_y;        // player spawn position in pixels
+    std::uint32_t object_count;  // amount of off-grid objects
+} LevelHeader;
+
+typedef struct LevelObject {
+    std::int32_t x;      // position in pixels
+    std::int32_t y;      // position in pixels
+    std::int32_t w;      // width in pixels
+    std::int32_t h;      // height in pixels
+    std::uint32_t kind;  // LevelObjectKind
+} LevelObject;
+
+static_assert(sizeof(LevelHeader) == 32, "LevelHeader must be packed");
+static_assert(sizeof(LevelObject) == 20, "LevelObject must be packed");
+
+inline std::uint64_t LevelCellsSize(std::int32_t columns, std::int32_t rows) {
+    // Cells are padded so the objects that follow stay 4 byte aligned
+    return (static_cast<std::uint64_t>(columns) * rows + 3) & ~3ULL;
+}
+
+#endif  // LEVEL_FORMAT_HPP
@@ -0,0 +1,26 @@
+#ifndef REPLAY_FORMAT_HPP
+#define REPLAY_FORMAT_HPP
+
+#include <cstdint>
+
+/* Input recording format
+ *
+ * ReplayHeader
+ * std::uint8_t actions[tick_count]  Action bits of every simulated tick
+ *
+ * All fields are little endian.
+ */
+
+constexpr char REPLAY_MAGIC[4] = {'R', 'P', 'L', '1'};
+constexpr std::uint32_t REPLAY_VERSION = 1;
+
+typedef struct ReplayHeader {
+    char magic[4];             // REPLAY_MAGIC
+    std::uint32_t version;     // REPLAY_VERSION
+    std::uint32_t tick_rate;   // simulation ticks per second of the run
+    std::uint32_t tick_count;  // amount of recorded ticks
+} ReplayHeader;
+
+static_assert(sizeof(ReplayHeader) == 16, "ReplayHeader must be packed");
+
+#endif  // REPLAY_FORMAT_HPP
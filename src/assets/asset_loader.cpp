@@ -0,0 +1,189 @@
+#include "asset_loader.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define HAVE_SYSCONF 1
+#endif
+
+namespace {
+
+// Bytes between touched bytes when the page size can't be queried
+constexpr size_t TOUCH_STRIDE = 4096;
+
+double MillisecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+// Reads a byte of every page so the page faults of the mapping are taken by
+// the worker instead of the thread that uploads the asset
+void TouchPages(const void *data, size_t size) {
+    const volatile Uint8 *bytes = static_cast<const volatile Uint8 *>(data);
+    size_t stride = TOUCH_STRIDE;
+
+#ifdef HAVE_SYSCONF
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0) {
+        stride = static_cast<size_t>(page_size);
+    }
+#endif
+
+    for (size_t i = 0; i < size; i += stride) {
+        bytes[i];
+    }
+}
+
+void LoadImage(const AssetPack *pack, AssetLoad *load) {
+    load->surface = LoadPackedImage(pack, load->name, load->path);
+
+    if (load->surface == NULL) {
+        load->error = SDL_GetError();
+        return;
+    }
+
+    const PackEntry *entry = FindAsset(pack, load->name);
+
+    if (entry != NULL && entry->kind == PACK_ENTRY_IMAGE) {
+        TouchPages(load->surface->pixels, entry->size);
+    }
+}
+
+void LoadMusic(const AssetPack *pack, AssetLoad *load) {
+    const PackEntry *entry = FindAsset(pack, load->name);
+
+    if (entry != NULL && entry->kind == PACK_ENTRY_FILE) {
+        // Music is streamed from the mapping while it plays
+        load->data = pack->file.data + entry->offset;
+        load->size = entry->size;
+        TouchPages(load->data, load->size);
+        return;
+    }
+
+    load->owned_data = SDL_LoadFile(load->path, &load->size);
+    load->data = load->owned_data;
+
+    if (load->data == NULL) {
+        load->error = SDL_GetError();
+    }
+}
+
+void RunWorker(AssetLoader *loader, int worker) {
+    for (;;) {
+        const size_t index = loader->next.fetch_add(1);
+
+        if (index >= loader->loads.size()) {
+            return;
+        }
+
+        AssetLoad *load = &loader->loads[index];
+        load->worker = worker;
+        load->start_ms = MillisecondsSince(loader->start);
+
+        if (load->kind == ASSET_IMAGE) {
+            LoadImage(loader->pack, load);
+        } else {
+            LoadMusic(loader->pack, load);
+        }
+
+        load->end_ms = MillisecondsSince(loader->start);
+    }
+}
+
+}  // namespace
+
+void InitAssetLoader(AssetLoader *loader, const AssetPack *pack) {
+    loader->pack = pack;
+    loader->loads.clear();
+    loader->workers.clear();
+    loader->next = 0;
+    loader->start = SDL_GetPerformanceCounter();
+    loader->wait_ms = 0.0;
+}
+
+int AddAsset(AssetLoader *loader, const char *name, const char *path,
+             AssetKind kind) {
+    AssetLoad load;
+    load.name = name;
+    load.path = path;
+    load.kind = kind;
+    load.surface = NULL;
+    load.data = NULL;
+    load.size = 0;
+    load.owned_data = NULL;
+    load.worker = -1;
+    load.start_ms = 0.0;
+    load.end_ms = 0.0;
+
+    loader->loads.push_back(load);
+
+    return static_cast<int>(loader->loads.size()) - 1;
+}
+
+void StartAssetLoader(AssetLoader *loader, int thread_count) {
+    // The image decoders are initialized once here, since loading them on
+    // the first IMG_Load of every worker at the same time isn't thread safe
+    IMG_Init(IMG_INIT_PNG);
+
+    const int load_count = static_cast<int>(loader->loads.size());
+    thread_count = std::max(1, std::min(thread_count, load_count));
+
+    loader->next = 0;
+    loader->start = SDL_GetPerformanceCounter();
+
+    for (int i = 0; i < thread_count; i++) {
+        loader->workers.push_back(std::thread(RunWorker, loader, i));
+    }
+}
+
+bool FinishAssetLoader(AssetLoader *loader) {
+    const Uint64 wait_start = SDL_GetPerformanceCounter();
+
+    for (std::thread &worker : loader->workers) {
+        worker.join();
+    }
+
+    if (!loader->workers.empty()) {
+        loader->wait_ms = MillisecondsSince(wait_start);
+        loader->workers.clear();
+    }
+
+    for (const AssetLoad &load : loader->loads) {
+        if (!load.error.empty()) {
+            SDL_SetError("%s: %s", load.path, load.error.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void PrintAssetTimings(const AssetLoader *loader) {
+    double end_ms = 0.0;
+    int worker_count = 0;
+
+    for (const AssetLoad &load : loader->loads) {
+        std::cout << "asset " << load.name << ": "
+                  << load.end_ms - load.start_ms << " ms on worker "
+                  << load.worker << " (" << load.start_ms << " - "
+                  << load.end_ms << " ms)" << std::endl;
+
+        end_ms = std::max(end_ms, load.end_ms);
+        worker_count = std::max(worker_count, load.worker + 1);
+    }
+
+    std::cout << "assets: " << loader->loads.size() << " loaded on "
+              << worker_count << " workers in " << end_ms
+              << " ms, main thread waited " << loader->wait_ms << " ms"
+              << std::endl;
+}
+
+void FreeAssetLoader(AssetLoader *loader) {
+    for (AssetLoad &load : loader->loads) {
+        SDL_free(load.owned_data);
+        load.owned_data = NULL;
+        load.data = NULL;
+    }
+}
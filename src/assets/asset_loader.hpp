@@ -0,0 +1,49 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asset_pack.hpp"
+
+enum AssetKind { ASSET_IMAGE = 0, ASSET_MUSIC = 1 };
+
+typedef struct AssetLoad {
+    const char *name;      // name of the asset in the pack
+    const char *path;      // loose file loaded when the pack doesn't have it
+    Uint8 kind;            // AssetKind of the asset
+    SDL_Surface *surface;  // decoded image
+    const void *data;      // music file contents
+    size_t size;           // size of the music file in bytes
+    void *owned_data;      // music read from a loose file, freed by the loader
+    std::string error;     // reason the load failed, empty on success
+    int worker;            // worker that loaded the asset
+    double start_ms;       // start of the load since the loader started
+    double end_ms;         // end of the load since the loader started
+} AssetLoad;
+
+typedef struct AssetLoader {
+    const AssetPack *pack;             // pack the assets are loaded from
+    std::vector<AssetLoad> loads;      // assets in the order they were added
+    std::vector<std::thread> workers;  // threads loading the assets
+    std::atomic<size_t> next;          // next load a worker picks up
+    Uint64 start;                      // performance counter at the start
+    double wait_ms;                    // time the caller blocked on workers
+} AssetLoader;
+
+void InitAssetLoader(AssetLoader *loader, const AssetPack *pack);
+
+int AddAsset(AssetLoader *loader, const char *name, const char *path,
+             AssetKind kind);
+
+void StartAssetLoader(AssetLoader *loader, int thread_count);
+
+bool FinishAssetLoader(AssetLoader *loader);
+
+void PrintAssetTimings(const AssetLoader *loader);
+
+void FreeAssetLoader(AssetLoader *loader);
+
+#endif  // ASSET_LOADER_HPP
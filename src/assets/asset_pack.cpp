@@ -0,0 +1,100 @@
+#include "asset_pack.hpp"
+
+#include <cstring>
+
+bool OpenAssetPack(AssetPack *pack, const char *path) {
+    pack->entries = NULL;
+    pack->entry_count = 0;
+
+    if (!MapFile(&pack->file, path)) {
+        return false;
+    }
+
+    const Uint8 *data = pack->file.data;
+    const size_t size = pack->file.size;
+    const PackHeader *header = reinterpret_cast<const PackHeader *>(data);
+
+    if (size < sizeof(PackHeader) ||
+        std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+        header->version != PACK_VERSION ||
+        sizeof(PackHeader) +
+                static_cast<Uint64>(header->entry_count) * sizeof(PackEntry) >
+            size) {
+        CloseAssetPack(pack);
+        SDL_SetError("%s is not a version %u asset pack", path, PACK_VERSION);
+        return false;
+    }
+
+    pack->entries = reinterpret_cast<const PackEntry *>(data + sizeof(*header));
+    pack->entry_count = static_cast<int>(header->entry_count);
+
+    for (int i = 0; i < pack->entry_count; i++) {
+        const PackEntry &entry = pack->entries[i];
+
+        // Written so a crafted offset can't wrap around the check
+        if (entry.offset > size || entry.size > size - entry.offset) {
+            CloseAssetPack(pack);
+            SDL_SetError("%s is truncated", path);
+            return false;
+        }
+
+        if (entry.kind != PACK_ENTRY_IMAGE) {
+            continue;
+        }
+
+        // Rows shorter than the pixels of the width would make the surface
+        // read past the data of the entry
+        const Uint64 row_size = static_cast<Uint64>(entry.width) *
+                                SDL_BYTESPERPIXEL(entry.format);
+
+        if (entry.width <= 0 || entry.height <= 0 || row_size == 0 ||
+            entry.pitch < 0 || static_cast<Uint64>(entry.pitch) < row_size ||
+            static_cast<Uint64>(entry.pitch) * entry.height > entry.size) {
+            CloseAssetPack(pack);
+            SDL_SetError("%s has a malformed image %.*s", path,
+                         PACK_NAME_SIZE, entry.name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const PackEntry *FindAsset(const AssetPack *pack, const char *name) {
+    if (pack == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < pack->entry_count; i++) {
+        if (std::strncmp(pack->entries[i].name, name, PACK_NAME_SIZE) == 0) {
+            return &pack->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+SDL_Surface *LoadPackedImage(const AssetPack *pack, const char *name,
+                             const char *fallback_path) {
+    const PackEntry *entry = FindAsset(pack, name);
+
+    if (entry == NULL || entry->kind != PACK_ENTRY_IMAGE) {
+        // Decode the loose file when the pack doesn't have the image
+        return IMG_Load(fallback_path);
+    }
+
+    // The surface uses the pixels in the mapping, nothing is copied. The
+    // mapping is read only, which is fine since sprites are only read from.
+    void *pixels = const_cast<Uint8 *>(pack->file.data + entry->offset);
+
+    return SDL_CreateRGBSurfaceWithFormatFrom(
+        pixels, entry->width, entry->height,
+        static_cast<int>(SDL_BITSPERPIXEL(entry->format)), entry->pitch,
+        entry->format);
+}
+
+void CloseAssetPack(AssetPack *pack) {
+    UnmapFile(&pack->file);
+    pack->entries = NULL;
+    pack->entry_count = 0;
+}
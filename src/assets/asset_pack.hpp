@@ -0,0 +1,22 @@
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+#include "../engine/mapped_file.hpp"
+#include "engine/asset_pack_format.hpp"
+
+typedef struct AssetPack {
+    MappedFile file;           // the pack mapped into memory
+    const PackEntry *entries;  // index of the assets in the pack
+    int entry_count;           // amount of assets in the pack
+} AssetPack;
+
+bool OpenAssetPack(AssetPack *pack, const char *path);
+
+const PackEntry *FindAsset(const AssetPack *pack, const char *name);
+
+SDL_Surface *LoadPackedImage(const AssetPack *pack, const char *name,
+                             const char *fallback_path);
+
+void CloseAssetPack(AssetPack *pack);
+
+#endif  // ASSET_PACK_HPP
@@ -0,0 +1,193 @@
+#include "aabb_kernel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Tests rectangles [first, count) one at a time, first is the index the
+// vector loop stopped at
+int OverlapRange(SDL_Rect player, const int *x, const int *y, const int *w,
+                 const int *h, int first, int count, Uint32 *mask) {
+    const int right = player.x + player.w;
+    const int bottom = player.y + player.h;
+    int contacts = 0;
+
+    for (int i = first; i < count; i++) {
+        const int dx = std::min(right, x[i] + w[i]) - std::max(player.x, x[i]);
+        const int dy = std::min(bottom, y[i] + h[i]) - std::max(player.y, y[i]);
+
+        if (dx > 0 && dy > 0) {
+            mask[i >> 5] |= 1U << (i & 31);
+            contacts += 1;
+        }
+    }
+
+    return contacts;
+}
+
+#if !defined(__AVX2__) && defined(__SSE2__)
+// SSE2 has no 32 bit integer min and max, so select with a comparison
+inline __m128i Min(__m128i a, __m128i b) {
+    const __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, b),
+                        _mm_andnot_si128(greater, a));
+}
+
+inline __m128i Max(__m128i a, __m128i b) {
+    const __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a),
+                        _mm_andnot_si128(greater, b));
+}
+#endif
+
+}  // namespace
+
+const char *AabbKernelName() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+int OverlapRectsScalar(SDL_Rect player, const int *x, const int *y,
+                       const int *w, const int *h, int count, Uint32 *mask) {
+    std::memset(mask, 0, ((count + 31) / 32) * sizeof(Uint32));
+
+    return OverlapRange(player, x, y, w, h, 0, count, mask);
+}
+
+int OverlapRects(SDL_Rect player, const int *x, const int *y, const int *w,
+                 const int *h, int count, Uint32 *mask) {
+    std::memset(mask, 0, ((count + 31) / 32) * sizeof(Uint32));
+
+    int i = 0;
+    int contacts = 0;
+
+#if defined(__AVX2__)
+    /* Eight rectangles at a time */
+    const __m256i left = _mm256_set1_epi32(player.x);
+    const __m256i top = _mm256_set1_epi32(player.y);
+    const __m256i right = _mm256_set1_epi32(player.x + player.w);
+    const __m256i bottom = _mm256_set1_epi32(player.y + player.h);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256i rx = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(x + i));
+        const __m256i ry = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(y + i));
+        const __m256i rw = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(w + i));
+        const __m256i rh = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(h + i));
+
+        const __m256i dx =
+            _mm256_sub_epi32(_mm256_min_epi32(right, _mm256_add_epi32(rx, rw)),
+                             _mm256_max_epi32(left, rx));
+        const __m256i dy =
+            _mm256_sub_epi32(_mm256_min_epi32(bottom, _mm256_add_epi32(ry, rh)),
+                             _mm256_max_epi32(top, ry));
+
+        const __m256i overlap = _mm256_and_si256(_mm256_cmpgt_epi32(dx, zero),
+                                                 _mm256_cmpgt_epi32(dy, zero));
+        const Uint32 bits = static_cast<Uint32>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(overlap)));
+
+        // i is a multiple of 8, so the lanes never straddle two words
+        mask[i >> 5] |= bits << (i & 31);
+        contacts += __builtin_popcount(bits);
+    }
+#elif defined(__SSE2__)
+    /* Four rectangles at a time */
+    const __m128i left = _mm_set1_epi32(player.x);
+    const __m128i top = _mm_set1_epi32(player.y);
+    const __m128i right = _mm_set1_epi32(player.x + player.w);
+    const __m128i bottom = _mm_set1_epi32(player.y + player.h);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i rx =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i));
+        const __m128i ry =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        const __m128i rw =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i));
+        const __m128i rh =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i));
+
+        const __m128i dx = _mm_sub_epi32(Min(right, _mm_add_epi32(rx, rw)),
+                                         Max(left, rx));
+        const __m128i dy = _mm_sub_epi32(Min(bottom, _mm_add_epi32(ry, rh)),
+                                         Max(top, ry));
+
+        const __m128i overlap = _mm_and_si128(_mm_cmpgt_epi32(dx, zero),
+                                              _mm_cmpgt_epi32(dy, zero));
+        const Uint32 bits =
+            static_cast<Uint32>(_mm_movemask_ps(_mm_castsi128_ps(overlap)));
+
+        // i is a multiple of 4, so the lanes never straddle two words
+        mask[i >> 5] |= bits << (i & 31);
+        contacts += __builtin_popcount(bits);
+    }
+#endif
+
+    /* Remaining rectangles */
+    return contacts + OverlapRange(player, x, y, w, h, i, count, mask);
+}
+
+int FindContacts(SDL_Rect player, const EntityStore *rects, int first,
+                 Contacts *contacts) {
+    const int count = EntityCount(rects);
+
+    contacts->mask.resize((count + 31) / 32 + 1);
+
+    if (first >= count) {
+        std::fill(contacts->mask.begin(), contacts->mask.end(), 0);
+        return 0;
+    }
+
+    // Rectangles before first are not tested, their bits stay clear. The
+    // start is rounded down to a word so the vector loop stays aligned to
+    // the mask words.
+    const int start = first & ~31;
+    std::fill(contacts->mask.begin(), contacts->mask.end(), 0);
+
+    int found = OverlapRects(player, &rects->x[start], &rects->y[start],
+                             &rects->w[start], &rects->h[start], count - start,
+                             &contacts->mask[start >> 5]);
+
+    // Drop the contacts between the word start and first
+    const Uint32 before = (1U << (first & 31)) - 1;
+    found -= __builtin_popcount(contacts->mask[start >> 5] & before);
+    contacts->mask[start >> 5] &= ~before;
+
+    return found;
+}
+
+int NextContact(const Contacts *contacts, int first, int count) {
+    /* Lowest set bit at or after first */
+    for (int word = first >> 5; word * 32 < count; word++) {
+        Uint32 bits = contacts->mask[word];
+
+        if (word == first >> 5) {
+            bits &= ~((1U << (first & 31)) - 1);
+        }
+
+        if (bits != 0) {
+            const int index = word * 32 + __builtin_ctz(bits);
+            return index < count ? index : -1;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,27 @@
+#ifndef AABB_KERNEL_HPP
+#define AABB_KERNEL_HPP
+
+#include <vector>
+
+#include "entity_store.hpp"
+
+// Overlaps of the player with a packed array of rectangles
+typedef struct Contacts {
+    std::vector<Uint32> mask;  // bit i is set when rectangle i is overlapped
+} Contacts;
+
+// Name of the instruction set OverlapRects was compiled for
+const char *AabbKernelName();
+
+int OverlapRectsScalar(SDL_Rect player, const int *x, const int *y,
+                       const int *w, const int *h, int count, Uint32 *mask);
+
+int OverlapRects(SDL_Rect player, const int *x, const int *y, const int *w,
+                 const int *h, int count, Uint32 *mask);
+
+int FindContacts(SDL_Rect player, const EntityStore *rects, int first,
+                 Contacts *contacts);
+
+int NextContact(const Contacts *contacts, int first, int count);
+
+#endif  // AABB_KERNEL_HPP
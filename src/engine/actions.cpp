@@ -0,0 +1,34 @@
+#include "actions.hpp"
+
+#include "physics.hpp"
+
+void ApplyActions(Player *player, Uint8 actions) {
+    CollisionState *collision_state = &player->collision_state;
+    MotionState *motion_state = &player->motion_state;
+
+    /* Pressed actions */
+    if ((actions & ACTION_JUMP) != 0 && collision_state->on_the_floor) {
+        // Player jumps
+        motion_state->jump = true;
+        collision_state->on_the_floor = false;
+        collision_state->on_the_platform = false;
+    } else if ((actions & ACTION_DROP) != 0 &&
+               collision_state->on_the_platform &&
+               collision_state->on_the_floor) {
+        // Player drops down from the platform
+        motion_state->drop = true;
+        collision_state->on_the_floor = false;
+        collision_state->on_the_platform = false;
+    }
+
+    /* Held actions */
+    if ((actions & ACTION_LEFT) != 0) {
+        // move player left
+        player->body.vx = -player->speed * FIXED_ONE;
+    } else if ((actions & ACTION_RIGHT) != 0) {
+        // move player right
+        player->body.vx = player->speed * FIXED_ONE;
+    } else {
+        player->body.vx = 0;
+    }
+}
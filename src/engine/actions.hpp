@@ -0,0 +1,20 @@
+#ifndef ACTIONS_HPP
+#define ACTIONS_HPP
+
+#include "engine/entities.hpp"
+
+// What the player asked for during one tick, resolved from the keyboard and
+// the controller. The simulation only sees these bits, so a run can be
+// recorded and simulated again without any devices.
+enum Action {
+    ACTION_LEFT = 1 << 0,   // walk left, held
+    ACTION_RIGHT = 1 << 1,  // walk right, held
+    ACTION_JUMP = 1 << 2,   // jump, pressed
+    ACTION_DROP = 1 << 3,   // drop down from a platform, pressed
+    ACTION_QUIT = 1 << 4,   // leave the game
+    ACTION_REWIND = 1 << 5  // step back a tick instead of simulating, held
+};
+
+void ApplyActions(Player *player, Uint8 actions);
+
+#endif  // ACTIONS_HPP
@@ -0,0 +1,110 @@
+#include "batch_env.hpp"
+
+#include "physics.hpp"
+#include "simulation.hpp"
+#include "world.hpp"
+
+namespace {
+
+constexpr int WORLD_GRAIN = 256;  // worlds per job
+
+void ResetWorld(BatchEnv *env, int world) {
+    env->players[world] = CreatePlayer(env->level);
+    env->ticks[world] = 0;
+}
+
+Observation Observe(const Player *player) {
+    Observation observation;
+    observation.x = player->dstrect.x;
+    observation.y = player->dstrect.y;
+    observation.vx = static_cast<Sint16>(ToPixels(player->body.vx));
+    observation.vy = static_cast<Sint16>(ToPixels(player->body.vy));
+    observation.flags =
+        (player->collision_state.on_the_floor ? OBSERVATION_ON_FLOOR : 0) |
+        (player->collision_state.on_the_platform ? OBSERVATION_ON_PLATFORM
+                                                 : 0) |
+        (player->motion_state.jump ? OBSERVATION_JUMP : 0);
+    return observation;
+}
+
+void StepJob(void *data, int begin, int end, int worker) {
+    BatchEnv *env = static_cast<BatchEnv *>(data);
+    const Level *level = env->level;
+
+    for (int world = begin; world < end; world++) {
+        Player *player = &env->players[world];
+        const int start_x = player->dstrect.x;
+
+        StepWorld(player, env->actions[world], level, env->objects,
+                  &env->scratch[worker], env->tick_rate, NULL);
+        env->ticks[world] += 1;
+
+        // Progress to the right is rewarded, in pixels
+        env->rewards[world] = static_cast<float>(player->dstrect.x - start_x);
+
+        const bool done =
+            player->dstrect.x + player->dstrect.w >= level->width ||
+            env->ticks[world] >= env->episode_ticks;
+        env->dones[world] = done ? 1 : 0;
+
+        if (done) {
+            ResetWorld(env, world);
+        }
+        env->observations[world] = Observe(player);
+    }
+}
+
+}  // namespace
+
+void InitBatchEnv(BatchEnv *env, const Level *level,
+                  const SpatialHash *objects, int world_count,
+                  int thread_count, int tick_rate, Uint32 episode_ticks) {
+    env->level = level;
+    env->objects = objects;
+    env->tick_rate = tick_rate;
+    env->episode_ticks = episode_ticks;
+    env->players.assign(world_count, Player());
+    env->ticks.assign(world_count, 0);
+
+    InitJobSystem(&env->jobs, thread_count);
+    env->scratch.assign(JobWorkerCount(&env->jobs), QueryScratch());
+
+    env->actions = NULL;
+    env->observations = NULL;
+    env->rewards = NULL;
+    env->dones = NULL;
+
+    for (int world = 0; world < world_count; world++) {
+        ResetWorld(env, world);
+    }
+}
+
+int WorldCount(const BatchEnv *env) {
+    return static_cast<int>(env->players.size());
+}
+
+void ResetBatchEnv(BatchEnv *env, Observation *observations) {
+    for (int world = 0; world < WorldCount(env); world++) {
+        ResetWorld(env, world);
+        observations[world] = Observe(&env->players[world]);
+    }
+}
+
+void StepBatchEnv(BatchEnv *env, const Uint8 *actions,
+                  Observation *observations, float *rewards, Uint8 *dones) {
+    /* One tick of every world */
+    // Each world writes only its own slots of the arrays
+    env->actions = actions;
+    env->observations = observations;
+    env->rewards = rewards;
+    env->dones = dones;
+
+    ParallelFor(&env->jobs, WorldCount(env), WORLD_GRAIN, StepJob, env);
+}
+
+void FreeBatchEnv(BatchEnv *env) {
+    FreeJobSystem(&env->jobs);
+    env->players.clear();
+    env->ticks.clear();
+    env->scratch.clear();
+}
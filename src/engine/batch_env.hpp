@@ -0,0 +1,62 @@
+#ifndef BATCH_ENV_HPP
+#define BATCH_ENV_HPP
+
+#include <vector>
+
+#include "broadphase.hpp"
+#include "engine/entities.hpp"
+#include "job_system.hpp"
+#include "level.hpp"
+
+enum ObservationFlag {
+    OBSERVATION_ON_FLOOR = 1 << 0,
+    OBSERVATION_ON_PLATFORM = 1 << 1,
+    OBSERVATION_JUMP = 1 << 2
+};
+
+// What a world shows its bot after a step, 16 bytes
+typedef struct Observation {
+    Sint32 x;      // left edge of the player in pixels
+    Sint32 y;      // top edge of the player in pixels
+    Sint16 vx;     // horizontal velocity in pixels/s
+    Sint16 vy;     // vertical velocity in pixels/s
+    Uint32 flags;  // ObservationFlag bits
+} Observation;
+
+static_assert(sizeof(Observation) == 16, "Observation must be packed");
+
+/* Batch environment */
+// Independent worlds playing the same level, for bots. The level and its
+// colliders are only read while stepping, so the worlds are split across
+// the job system and each worker sweeps with its own buffers. A world is
+// done when the player reaches the right edge of the level or the episode
+// runs out of ticks, and starts over at the spawn on the same step.
+typedef struct BatchEnv {
+    const Level *level;                 // level of every world
+    const SpatialHash *objects;         // colliders off the tile grid
+    int tick_rate;                      // simulation ticks per second
+    Uint32 episode_ticks;               // ticks before a world starts over
+    std::vector<Player> players;        // player of each world
+    std::vector<Uint32> ticks;          // ticks since each world started
+    std::vector<QueryScratch> scratch;  // sweep buffers per worker
+    JobSystem jobs;                     // workers stepping the worlds
+    const Uint8 *actions;               // Action bits per world of the step
+    Observation *observations;          // observations the step writes
+    float *rewards;                     // rewards the step writes
+    Uint8 *dones;                       // whether each world started over
+} BatchEnv;
+
+void InitBatchEnv(BatchEnv *env, const Level *level,
+                  const SpatialHash *objects, int world_count,
+                  int thread_count, int tick_rate, Uint32 episode_ticks);
+
+int WorldCount(const BatchEnv *env);
+
+void ResetBatchEnv(BatchEnv *env, Observation *observations);
+
+void StepBatchEnv(BatchEnv *env, const Uint8 *actions,
+                  Observation *observations, float *rewards, Uint8 *dones);
+
+void FreeBatchEnv(BatchEnv *env);
+
+#endif  // BATCH_ENV_HPP
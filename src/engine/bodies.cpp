@@ -0,0 +1,72 @@
+#include "bodies.hpp"
+
+#include "collision.hpp"
+#include "physics.hpp"
+
+void ClearBodies(BodyStore *bodies) {
+    bodies->x.clear();
+    bodies->y.clear();
+    bodies->vx.clear();
+    bodies->vy.clear();
+    bodies->w.clear();
+    bodies->h.clear();
+    bodies->on_floor.clear();
+}
+
+int AddBody(BodyStore *bodies, SDL_Rect rect, int speed) {
+    bodies->x.push_back(ToFixed(rect.x));
+    bodies->y.push_back(ToFixed(rect.y));
+    bodies->vx.push_back(ToFixed(speed));
+    bodies->vy.push_back(0);
+    bodies->w.push_back(rect.w);
+    bodies->h.push_back(rect.h);
+    bodies->on_floor.push_back(0);
+
+    return BodyCount(bodies) - 1;
+}
+
+int BodyCount(const BodyStore *bodies) {
+    return static_cast<int>(bodies->x.size());
+}
+
+SDL_Rect BodyRect(const BodyStore *bodies, int index) {
+    return SDL_Rect{ToPixels(bodies->x[index]), ToPixels(bodies->y[index]),
+                    bodies->w[index], bodies->h[index]};
+}
+
+void UpdateBodies(BodyStore *bodies, int begin, int end,
+                  const TileMap *tilemap, const SpatialHash *objects,
+                  QueryScratch *scratch, int tick_rate) {
+    for (int i = begin; i < end; i++) {
+        const SDL_Rect start = BodyRect(bodies, i);
+
+        /* Integration */
+        bodies->y[i] += FallStep(&bodies->vy[i], tick_rate);
+        bodies->x[i] += bodies->vx[i] / tick_rate;
+
+        /* Collision with the static world */
+        const SDL_Rect target = BodyRect(bodies, i);
+        CollisionState state = {false, false};
+        const SDL_Rect rect =
+            SweepRect(start, target, tilemap, objects, scratch, &state);
+
+        // A body walking into a wall jumps over it when it stands on the
+        // ground, and turns around when it is already in the air
+        if (rect.x != target.x) {
+            bodies->x[i] = ToFixed(rect.x);
+
+            if (state.on_the_floor) {
+                bodies->vy[i] = -ToFixed(BODY_JUMP_SPEED);
+            } else {
+                bodies->vx[i] = -bodies->vx[i];
+            }
+        }
+
+        if (rect.y != target.y || (state.on_the_floor && bodies->vy[i] > 0)) {
+            bodies->y[i] = ToFixed(rect.y);
+            bodies->vy[i] = 0;
+        }
+
+        bodies->on_floor[i] = state.on_the_floor;
+    }
+}
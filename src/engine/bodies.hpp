@@ -0,0 +1,37 @@
+#ifndef BODIES_HPP
+#define BODIES_HPP
+
+#include <vector>
+
+#include "broadphase.hpp"
+#include "tilemap.hpp"
+
+/* Dynamic bodies */
+// Enemies, projectiles and the like, in the fixed-point units of the player.
+// Bodies only collide with the static world, so each one is updated on its
+// own and the bodies can be split across threads without changing results.
+typedef struct BodyStore {
+    std::vector<Sint32> x;        // left edge in fixed-point
+    std::vector<Sint32> y;        // top edge in fixed-point
+    std::vector<Sint32> vx;       // horizontal velocity in fixed-point/s
+    std::vector<Sint32> vy;       // vertical velocity in fixed-point/s
+    std::vector<int> w;           // width in pixels
+    std::vector<int> h;           // height in pixels
+    std::vector<Uint8> on_floor;  // whether the body stands on something
+} BodyStore;
+
+constexpr int BODY_JUMP_SPEED = 360;  // jump over a wall in pixels/s
+
+void ClearBodies(BodyStore *bodies);
+
+int AddBody(BodyStore *bodies, SDL_Rect rect, int speed);
+
+int BodyCount(const BodyStore *bodies);
+
+SDL_Rect BodyRect(const BodyStore *bodies, int index);
+
+void UpdateBodies(BodyStore *bodies, int begin, int end,
+                  const TileMap *tilemap, const SpatialHash *objects,
+                  QueryScratch *scratch, int tick_rate);
+
+#endif  // BODIES_HPP
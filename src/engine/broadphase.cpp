@@ -0,0 +1,98 @@
+#include "broadphase.hpp"
+
+#include <algorithm>
+
+namespace {
+
+unsigned CellBucket(const SpatialHash *hash, int column, int row) {
+    const unsigned h = static_cast<unsigned>(column) * 73856093U ^
+                       static_cast<unsigned>(row) * 19349663U;
+    return h & hash->bucket_mask;
+}
+
+int CellOf(int coordinate, int cell_size) {
+    // Round towards negative infinity so colliders left of or above the
+    // origin land in their own cells
+    return coordinate >= 0 ? coordinate / cell_size
+                           : (coordinate - cell_size + 1) / cell_size;
+}
+
+}  // namespace
+
+void InitSpatialHash(SpatialHash *hash, int cell_size, int bucket_count) {
+    // Round the bucket count up to a power of two for masking
+    unsigned buckets = 1;
+    while (buckets < static_cast<unsigned>(bucket_count)) {
+        buckets <<= 1;
+    }
+
+    hash->cell_size = cell_size;
+    hash->bucket_mask = buckets - 1;
+    ClearEntities(&hash->colliders);
+    hash->buckets.assign(buckets, std::vector<int>());
+    hash->stats = BroadphaseStats{0, 0, 0};
+}
+
+void InsertCollider(SpatialHash *hash, SDL_Rect rect, Uint8 kind,
+                    Uint8 sprite) {
+    const int index = AddEntity(&hash->colliders, rect, kind, sprite);
+
+    const int first_column = CellOf(rect.x, hash->cell_size);
+    const int last_column = CellOf(rect.x + rect.w, hash->cell_size);
+    const int first_row = CellOf(rect.y, hash->cell_size);
+    const int last_row = CellOf(rect.y + rect.h, hash->cell_size);
+
+    for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+            std::vector<int> &bucket =
+                hash->buckets[CellBucket(hash, column, row)];
+
+            // A collider spanning several cells can hash to the same bucket
+            if (bucket.empty() || bucket.back() != index) {
+                bucket.push_back(index);
+            }
+        }
+    }
+}
+
+void FindCandidates(const SpatialHash *hash, SDL_Rect area,
+                    std::vector<int> *candidates) {
+    /* Candidates whose bounds touch the area */
+    // Only reads the hash, so threads can query it at the same time
+    candidates->clear();
+
+    const EntityStore &colliders = hash->colliders;
+
+    if (colliders.x.empty()) {
+        return;
+    }
+
+    const int first_column = CellOf(area.x, hash->cell_size);
+    const int last_column = CellOf(area.x + area.w, hash->cell_size);
+    const int first_row = CellOf(area.y, hash->cell_size);
+    const int last_row = CellOf(area.y + area.h, hash->cell_size);
+
+    for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+            const std::vector<int> &bucket =
+                hash->buckets[CellBucket(hash, column, row)];
+
+            for (int index : bucket) {
+                // Buckets are shared between cells, so drop colliders that
+                // are not near the area
+                const int x = colliders.x[index];
+                const int y = colliders.y[index];
+                if (x <= area.x + area.w && area.x <= x + colliders.w[index] &&
+                    y <= area.y + area.h && area.y <= y + colliders.h[index]) {
+                    candidates->push_back(index);
+                }
+            }
+        }
+    }
+
+    // Colliders spanning several cells are found once per cell. Resolve
+    // contacts in insertion order like the brute force loop did.
+    std::sort(candidates->begin(), candidates->end());
+    candidates->erase(std::unique(candidates->begin(), candidates->end()),
+                      candidates->end());
+}
@@ -0,0 +1,41 @@
+#ifndef BROADPHASE_HPP
+#define BROADPHASE_HPP
+
+#include <vector>
+
+#include "aabb_kernel.hpp"
+#include "entity_store.hpp"
+
+enum ColliderKind { COLLIDER_BLOCK = 0, COLLIDER_PLATFORM = 1 };
+
+typedef struct BroadphaseStats {
+    Uint64 queries;     // amount of queries
+    Uint64 candidates;  // candidates returned to the narrowphase
+    Uint64 objects;     // colliders that brute force would have tested
+} BroadphaseStats;
+
+// Buffers of one sweep, every thread that sweeps needs its own
+typedef struct QueryScratch {
+    std::vector<int> candidates;  // colliders near the swept area
+    EntityStore packed;           // colliders packed for the kernel
+    Contacts contacts;            // overlaps with the packed colliders
+} QueryScratch;
+
+typedef struct SpatialHash {
+    int cell_size;                          // width and height of a cell
+    unsigned bucket_mask;                   // bucket count minus one
+    EntityStore colliders;                  // colliders in insertion order
+    std::vector<std::vector<int>> buckets;  // collider indices per bucket
+    QueryScratch scratch;                   // buffers of the player sweep
+    BroadphaseStats stats;
+} SpatialHash;
+
+void InitSpatialHash(SpatialHash *hash, int cell_size, int bucket_count);
+
+void InsertCollider(SpatialHash *hash, SDL_Rect rect, Uint8 kind,
+                    Uint8 sprite);
+
+void FindCandidates(const SpatialHash *hash, SDL_Rect area,
+                    std::vector<int> *candidates);
+
+#endif  // BROADPHASE_HPP
@@ -0,0 +1,39 @@
+#include "camera.hpp"
+
+#include <algorithm>
+
+namespace {
+
+int ClampView(int position, int view_size, int level_size) {
+    // Levels smaller than the window stay at the top left corner
+    return std::max(0, std::min(position, level_size - view_size));
+}
+
+}  // namespace
+
+void InitCamera(Camera *camera, int view_width, int view_height,
+                int level_width, int level_height) {
+    camera->view.x = 0;
+    camera->view.y = 0;
+    camera->view.w = view_width;
+    camera->view.h = view_height;
+    camera->level_width = level_width;
+    camera->level_height = level_height;
+}
+
+void FollowCamera(Camera *camera, SDL_Rect target) {
+    /* Center the target */
+    const int x = target.x + target.w / 2 - camera->view.w / 2;
+    const int y = target.y + target.h / 2 - camera->view.h / 2;
+
+    /* Keep the view inside the level */
+    camera->view.x = ClampView(x, camera->view.w, camera->level_width);
+    camera->view.y = ClampView(y, camera->view.h, camera->level_height);
+}
+
+SDL_Rect WorldToScreen(const Camera *camera, SDL_Rect rect) {
+    rect.x -= camera->view.x;
+    rect.y -= camera->view.y;
+
+    return rect;
+}
@@ -0,0 +1,18 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+// Part of the level that is shown in the window
+typedef struct Camera {
+    SDL_Rect view;     // area of the level in the window
+    int level_width;   // width of the level in pixels
+    int level_height;  // height of the level in pixels
+} Camera;
+
+void InitCamera(Camera *camera, int view_width, int view_height,
+                int level_width, int level_height);
+
+void FollowCamera(Camera *camera, SDL_Rect target);
+
+SDL_Rect WorldToScreen(const Camera *camera, SDL_Rect rect);
+
+#endif  // CAMERA_HPP
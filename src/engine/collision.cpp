@@ -1,141 +1,155 @@
 #include "collision.hpp"
 
-void PlayerBlockCollision(Player *player, Block *block,
-                          CollisionState *collision_state) {
-    const int offset = 5;
-
-    const int p_width = player->dstrect.w;
-    const int p_height = player->dstrect.h;
-
-    const int w_width = block->dstrect.w;
-    const int w_height = block->dstrect.h;
-
-    /* X Axis Collision */
-    if (player->dstrect.y > block->dstrect.y + offset &&
-        player->dstrect.y < block->dstrect.y + w_height - offset) {
-        if (player->dstrect.x + p_width > block->dstrect.x &&
-            player->dstrect.x + p_width < block->dstrect.x + w_width) {
-            // left collision
-            player->dstrect.x -= player->speed;
-        } else if (player->dstrect.x < block->dstrect.x + w_width &&
-                   player->dstrect.x > block->dstrect.x) {
-            // right collision
-            player->dstrect.x += player->speed;
-        }
-    }
+#include <algorithm>
 
-    else if (player->dstrect.y + p_height > block->dstrect.y + offset &&
-             player->dstrect.y + p_height <
-                 block->dstrect.y + w_height - offset) {
-        if (player->dstrect.x + p_width > block->dstrect.x &&
-            player->dstrect.x + p_width < block->dstrect.x + w_width) {
-            // left collision
-            player->dstrect.x -= player->speed;
-        } else if (player->dstrect.x < block->dstrect.x + w_width &&
-                   player->dstrect.x > block->dstrect.x) {
-            // right collision
-            player->dstrect.x += player->speed;
-        }
-    }
+namespace {
 
-    else if (player->dstrect.y + p_height / 2 > block->dstrect.y &&
-             player->dstrect.y + p_height / 2 < block->dstrect.y + w_height) {
-        if (player->dstrect.x + p_width > block->dstrect.x &&
-            player->dstrect.x + p_width < block->dstrect.x + w_width) {
-            // left collision
-            player->dstrect.x -= player->speed;
-        } else if (player->dstrect.x < block->dstrect.x + w_width &&
-                   player->dstrect.x > block->dstrect.x) {
-            // right collision
-            player->dstrect.x += player->speed;
-        }
+typedef struct Hit {
+    int distance;        // how far the player moves before touching
+    bool platform_only;  // only platforms are touched at that distance
+} Hit;
+
+// Rectangle covered by moving rect by delta along one axis
+SDL_Rect SweptRect(SDL_Rect rect, int delta, bool vertical) {
+    if (vertical) {
+        rect.h += std::abs(delta);
+        rect.y = std::min(rect.y, rect.y + delta);
+    } else {
+        rect.w += std::abs(delta);
+        rect.x = std::min(rect.x, rect.x + delta);
     }
+    return rect;
+}
 
-    /* Y Axis Collision */
-    if (player->dstrect.x > block->dstrect.x &&
-        player->dstrect.x < block->dstrect.x + w_width) {
-        if (player->dstrect.y + p_height > block->dstrect.y &&
-            player->dstrect.y + p_height < block->dstrect.y + w_height) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-        } else if (player->dstrect.y < block->dstrect.y + w_height &&
-                   player->dstrect.y > block->dstrect.y) {
-            // bottom collision
-            player->dstrect.y += player->accel;
-        }
+// Time of impact of rect moving by delta along one axis. Only colliders
+// ahead of the player at the start of the move can stop it, so colliders
+// the player already overlaps are let go, and platforms only stop a player
+// falling onto them from above.
+Hit SweepAxis(SDL_Rect rect, int delta, bool vertical,
+              const EntityStore *colliders, Contacts *contacts) {
+    Hit hit = {delta, false};
+
+    if (delta == 0) {
+        return hit;
     }
 
-    else if (player->dstrect.x + p_width > block->dstrect.x &&
-             player->dstrect.x + p_width < block->dstrect.x + w_width) {
-        if (player->dstrect.y + p_height > block->dstrect.y &&
-            player->dstrect.y + p_height < block->dstrect.y + w_height) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-        } else if (player->dstrect.y < block->dstrect.y + w_height &&
-                   player->dstrect.y > block->dstrect.y) {
-            // bottom collision
-            player->dstrect.y += player->accel;
+    FindContacts(SweptRect(rect, delta, vertical), colliders, 0, contacts);
+
+    const int count = EntityCount(colliders);
+    const int near = vertical ? rect.y : rect.x;
+    const int far = vertical ? rect.y + rect.h : rect.x + rect.w;
+
+    for (int i = NextContact(contacts, 0, count); i != -1;
+         i = NextContact(contacts, i + 1, count)) {
+        const bool platform = colliders->kind[i] == COLLIDER_PLATFORM;
+        const int start = vertical ? colliders->y[i] : colliders->x[i];
+        const int end = start + (vertical ? colliders->h[i] : colliders->w[i]);
+
+        int distance;
+        if (delta > 0 && start >= far && (!platform || vertical)) {
+            distance = start - far;
+        } else if (delta < 0 && end <= near && !platform) {
+            distance = end - near;
+        } else {
+            continue;
         }
-    }
 
-    else if (player->dstrect.x + p_width / 2 > block->dstrect.x &&
-             player->dstrect.x + p_width / 2 < block->dstrect.x + w_width) {
-        if (player->dstrect.y + p_height > block->dstrect.y &&
-            player->dstrect.y + p_height < block->dstrect.y + w_height) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-        } else if (player->dstrect.y < block->dstrect.y + w_height &&
-                   player->dstrect.y > block->dstrect.y) {
-            // bottom collision
-            player->dstrect.y += player->accel;
+        if (std::abs(distance) < std::abs(hit.distance)) {
+            hit.distance = distance;
+            hit.platform_only = platform;
+        } else if (distance == hit.distance) {
+            hit.platform_only = hit.platform_only && platform;
         }
     }
+
+    return hit;
 }
 
-void PlayerPlatformCollision(Player *player, Platform *platform,
-                             CollisionState *collision_state) {
-    const int p_width = player->dstrect.w;
-    const int p_height = player->dstrect.h;
-
-    const int pl_width = platform->dstrect.w;
-
-    /* Y Axis Collision */
-    if (player->dstrect.x > platform->dstrect.x &&
-        player->dstrect.x < platform->dstrect.x + pl_width) {
-        if (player->dstrect.y + p_height > platform->dstrect.y &&
-            player->dstrect.y + p_height <
-                platform->dstrect.y + 2 * player->accel) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-            collision_state->on_the_platform = true;
+}  // namespace
+
+void GatherColliders(SDL_Rect area, const TileMap *tilemap,
+                     const SpatialHash *objects, QueryScratch *scratch) {
+    const int size = tilemap->tile_size;
+    EntityStore *colliders = &scratch->packed;
+
+    ClearEntities(colliders);
+
+    /* Merged tiles inside the area */
+    // A collider covers many cells, sorted once so each is packed once
+    const int first_column = std::max(0, area.x / size);
+    const int last_column =
+        std::min(tilemap->columns - 1, (area.x + area.w) / size);
+    const int first_row = std::max(0, area.y / size);
+    const int last_row = std::min(tilemap->rows - 1, (area.y + area.h) / size);
+    std::vector<int> *candidates = &scratch->candidates;
+
+    candidates->clear();
+
+    for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+            const int index = TileCollider(tilemap, column, row);
+
+            if (index != -1) {
+                candidates->push_back(index);
+            }
         }
     }
 
-    else if (player->dstrect.x + p_width > platform->dstrect.x &&
-             player->dstrect.x + p_width < platform->dstrect.x + pl_width) {
-        if (player->dstrect.y + p_height > platform->dstrect.y &&
-            player->dstrect.y + p_height <
-                platform->dstrect.y + 2 * player->accel) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-            collision_state->on_the_platform = true;
-        }
+    std::sort(candidates->begin(), candidates->end());
+    candidates->erase(std::unique(candidates->begin(), candidates->end()),
+                      candidates->end());
+
+    for (int index : *candidates) {
+        AddEntity(colliders, EntityRect(&tilemap->colliders, index),
+                  tilemap->colliders.kind[index], 0);
     }
 
-    else if (player->dstrect.x + p_width / 2 > platform->dstrect.x &&
-             player->dstrect.x + p_width / 2 < platform->dstrect.x + pl_width) {
-        if (player->dstrect.y + p_height > platform->dstrect.y &&
-            player->dstrect.y + p_height <
-                platform->dstrect.y + 2 * player->accel) {
-            // top collision
-            player->dstrect.y -= player->accel;
-            collision_state->on_the_floor = true;
-            collision_state->on_the_platform = true;
-        }
+    /* Objects off the tile grid */
+    FindCandidates(objects, area, &scratch->candidates);
+
+    for (int index : scratch->candidates) {
+        AddEntity(colliders, EntityRect(&objects->colliders, index),
+                  objects->colliders.kind[index],
+                  objects->colliders.sprite[index]);
     }
 }
+
+SDL_Rect SweepRect(SDL_Rect start, SDL_Rect target, const TileMap *tilemap,
+                   const SpatialHash *objects, QueryScratch *scratch,
+                   CollisionState *collision_state) {
+    /* Swept AABB */
+    // The rectangle moves from start to target, first horizontally and then
+    // vertically. Each axis stops at the first collider in the way, however
+    // far the rectangle moves in one tick.
+    const int dx = target.x - start.x;
+    const int dy = target.y - start.y;
+
+    // One pixel more below the rectangle for the ground probe
+    SDL_Rect area = SweptRect(SweptRect(start, dx, false), dy, true);
+    area.h += 1;
+    GatherColliders(area, tilemap, objects, scratch);
+
+    SDL_Rect rect = start;
+
+    const Hit hit_x =
+        SweepAxis(rect, dx, false, &scratch->packed, &scratch->contacts);
+    rect.x += hit_x.distance;
+
+    const Hit hit_y =
+        SweepAxis(rect, dy, true, &scratch->packed, &scratch->contacts);
+    rect.y += hit_y.distance;
+
+    /* Ground contact of this tick */
+    // Sub-pixel motion can leave a falling body on the same pixel, so the
+    // ground is probed one pixel below instead of relying on the sweep
+    Hit ground = {1, false};
+    if (dy >= 0) {
+        ground = SweepAxis(rect, 1, true, &scratch->packed, &scratch->contacts);
+    }
+
+    collision_state->on_the_floor = ground.distance == 0;
+    collision_state->on_the_platform =
+        collision_state->on_the_floor && ground.platform_only;
+
+    return rect;
+}
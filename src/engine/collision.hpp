@@ -1,12 +1,16 @@
 #ifndef COLLISION_HPP
 #define COLLISION_HPP
 
+#include "aabb_kernel.hpp"
+#include "broadphase.hpp"
 #include "engine/entities.hpp"
+#include "tilemap.hpp"
 
-void PlayerPlatformCollision(Player *player, Platform *platform,
-                             CollisionState *collision_state);
+void GatherColliders(SDL_Rect area, const TileMap *tilemap,
+                     const SpatialHash *objects, QueryScratch *scratch);
 
-void PlayerBlockCollision(Player *player, Block *block,
-                          CollisionState *collision_state);
+SDL_Rect SweepRect(SDL_Rect start, SDL_Rect target, const TileMap *tilemap,
+                   const SpatialHash *objects, QueryScratch *scratch,
+                   CollisionState *collision_state);
 
 #endif  // COLLISION_HPP
@@ -0,0 +1,32 @@
+#include "entity_store.hpp"
+
+void ClearEntities(EntityStore *store) {
+    store->x.clear();
+    store->y.clear();
+    store->w.clear();
+    store->h.clear();
+    store->kind.clear();
+    store->sprite.clear();
+}
+
+int AddEntity(EntityStore *store, SDL_Rect rect, Uint8 kind, Uint8 sprite) {
+    store->x.push_back(rect.x);
+    store->y.push_back(rect.y);
+    store->w.push_back(rect.w);
+    store->h.push_back(rect.h);
+    store->kind.push_back(kind);
+    store->sprite.push_back(sprite);
+
+    return static_cast<int>(store->x.size()) - 1;
+}
+
+int EntityCount(const EntityStore *store) {
+    return static_cast<int>(store->x.size());
+}
+
+SDL_Rect EntityRect(const EntityStore *store, int index) {
+    SDL_Rect rect = {store->x[index], store->y[index], store->w[index],
+                     store->h[index]};
+
+    return rect;
+}
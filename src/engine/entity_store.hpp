@@ -0,0 +1,26 @@
+#ifndef ENTITY_STORE_HPP
+#define ENTITY_STORE_HPP
+
+#include <vector>
+
+// Static entities of the level stored as one array per field, so a pass
+// only streams the fields it reads. Collision reads the bounds and kinds,
+// rendering the bounds and sprites.
+typedef struct EntityStore {
+    std::vector<int> x;         // left edge in the level
+    std::vector<int> y;         // top edge in the level
+    std::vector<int> w;         // width in pixels
+    std::vector<int> h;         // height in pixels
+    std::vector<Uint8> kind;    // what the entity collides as
+    std::vector<Uint8> sprite;  // sprite the entity is drawn with
+} EntityStore;
+
+void ClearEntities(EntityStore *store);
+
+int AddEntity(EntityStore *store, SDL_Rect rect, Uint8 kind, Uint8 sprite);
+
+int EntityCount(const EntityStore *store);
+
+SDL_Rect EntityRect(const EntityStore *store, int index);
+
+#endif  // ENTITY_STORE_HPP
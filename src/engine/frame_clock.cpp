@@ -0,0 +1,132 @@
+#include "frame_clock.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void InitFrameClock(FrameClock *clock, int tick_rate, int frame_rate) {
+    clock->frequency = SDL_GetPerformanceFrequency();
+    clock->tick_counts = clock->frequency / static_cast<Uint64>(tick_rate);
+    clock->frame_counts = clock->frequency / static_cast<Uint64>(frame_rate);
+    clock->previous = SDL_GetPerformanceCounter();
+    clock->accumulator = 0;
+    clock->next_frame = clock->previous + clock->frame_counts;
+}
+
+int AdvanceFrameClock(FrameClock *clock, int max_ticks, FrameStats *stats) {
+    /* Fixed timestep accumulator */
+    const Uint64 now = SDL_GetPerformanceCounter();
+    const Uint64 elapsed = now - clock->previous;
+    clock->previous = now;
+
+    if (stats != NULL) {
+        AddFrameTime(stats, 1000.0 * static_cast<double>(elapsed) /
+                                static_cast<double>(clock->frequency));
+    }
+
+    clock->accumulator += elapsed;
+
+    int ticks = 0;
+    while (clock->accumulator >= clock->tick_counts) {
+        clock->accumulator -= clock->tick_counts;
+        ticks += 1;
+    }
+
+    // Drop the backlog instead of spiralling when the simulation falls
+    // behind (debugger breaks, window drags, ...)
+    if (ticks > max_ticks) {
+        ticks = max_ticks;
+        clock->accumulator = 0;
+    }
+
+    return ticks;
+}
+
+void WaitForNextFrame(FrameClock *clock) {
+    /* Hybrid sleep and spin frame pacing */
+    // SDL_Delay only guarantees a minimum sleep, so sleep in 1 ms steps until
+    // the deadline is close and spin on the performance counter for the rest.
+    const Uint64 spin_counts = clock->frequency / 500;  // last 2 ms
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now + spin_counts < clock->next_frame) {
+        SDL_Delay(1);
+        now = SDL_GetPerformanceCounter();
+    }
+    while (now < clock->next_frame) {
+        now = SDL_GetPerformanceCounter();
+    }
+
+    clock->next_frame += clock->frame_counts;
+
+    // Resynchronize when a frame overran its budget instead of rendering a
+    // burst of frames to catch up
+    if (clock->next_frame < now) {
+        clock->next_frame = now + clock->frame_counts;
+    }
+}
+
+bool WaitForEvent(FrameClock *clock, int timeout_ms) {
+    /* Block until an event or the timeout */
+    // The event stays in the queue for the next poll
+    const bool event = SDL_WaitEventTimeout(NULL, timeout_ms) == 1;
+    ResumeFrameClock(clock);
+
+    return event;
+}
+
+void ResumeFrameClock(FrameClock *clock) {
+    // Nothing changed while waiting, so the time is not simulated. One tick
+    // is due right away so whatever woke the loop is simulated at once, and
+    // the frames are paced from here on.
+    const Uint64 now = SDL_GetPerformanceCounter();
+    clock->previous = now;
+    clock->accumulator = clock->tick_counts;
+    clock->next_frame = now + clock->frame_counts;
+}
+
+Uint64 CountsUntilNextTick(const FrameClock *clock) {
+    const Uint64 due =
+        clock->previous + clock->tick_counts - clock->accumulator;
+    const Uint64 now = SDL_GetPerformanceCounter();
+    return due > now ? due - now : 0;
+}
+
+SDL_Rect InterpolateRect(SDL_Rect previous, SDL_Rect current, double alpha) {
+    SDL_Rect rect = current;
+    rect.x = static_cast<int>(
+        std::lround(previous.x + (current.x - previous.x) * alpha));
+    rect.y = static_cast<int>(
+        std::lround(previous.y + (current.y - previous.y) * alpha));
+    return rect;
+}
+
+void InitFrameStats(FrameStats *stats, size_t capacity) {
+    stats->frame_ms.assign(capacity, 0.0);
+    stats->next = 0;
+    stats->count = 0;
+}
+
+void AddFrameTime(FrameStats *stats, double ms) {
+    if (stats->frame_ms.empty()) {
+        return;
+    }
+
+    stats->frame_ms[stats->next] = ms;
+    stats->next = (stats->next + 1) % stats->frame_ms.size();
+    stats->count = std::min(stats->count + 1, stats->frame_ms.size());
+}
+
+double FrameTimePercentile(const FrameStats *stats, double percentile) {
+    if (stats->count == 0) {
+        return 0.0;
+    }
+
+    std::vector<double> sorted(stats->frame_ms.begin(),
+                               stats->frame_ms.begin() +
+                                   static_cast<long>(stats->count));
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t index = static_cast<size_t>(percentile *
+                                       static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
@@ -0,0 +1,41 @@
+#ifndef FRAME_CLOCK_HPP
+#define FRAME_CLOCK_HPP
+
+#include <vector>
+
+typedef struct FrameClock {
+    Uint64 frequency;     // performance counter ticks per second
+    Uint64 tick_counts;   // performance counter ticks per simulation tick
+    Uint64 frame_counts;  // performance counter ticks per rendered frame
+    Uint64 previous;      // counter value at the start of the last frame
+    Uint64 accumulator;   // time that has not been simulated yet
+    Uint64 next_frame;    // counter value the next frame should start at
+} FrameClock;
+
+typedef struct FrameStats {
+    std::vector<double> frame_ms;  // ring of the most recent frame times
+    size_t next;                   // next slot to overwrite in the ring
+    size_t count;                  // amount of recorded frames
+} FrameStats;
+
+void InitFrameClock(FrameClock *clock, int tick_rate, int frame_rate);
+
+int AdvanceFrameClock(FrameClock *clock, int max_ticks, FrameStats *stats);
+
+void WaitForNextFrame(FrameClock *clock);
+
+bool WaitForEvent(FrameClock *clock, int timeout_ms);
+
+void ResumeFrameClock(FrameClock *clock);
+
+Uint64 CountsUntilNextTick(const FrameClock *clock);
+
+SDL_Rect InterpolateRect(SDL_Rect previous, SDL_Rect current, double alpha);
+
+void InitFrameStats(FrameStats *stats, size_t capacity);
+
+void AddFrameTime(FrameStats *stats, double ms);
+
+double FrameTimePercentile(const FrameStats *stats, double percentile);
+
+#endif  // FRAME_CLOCK_HPP
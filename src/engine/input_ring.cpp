@@ -0,0 +1,34 @@
+#include "input_ring.hpp"
+
+void InitInputRing(InputRing *ring, size_t capacity) {
+    ring->events.assign(capacity, InputEvent());
+    ring->read.store(0);
+    ring->write.store(0);
+    ring->dropped = 0;
+}
+
+void PushInput(InputRing *ring, const InputEvent *event) {
+    const Uint64 write = ring->write.load(std::memory_order_relaxed);
+
+    if (write - ring->read.load(std::memory_order_acquire) ==
+        ring->events.size()) {
+        ring->dropped += 1;
+        return;
+    }
+
+    // The press is written before the taker can see it
+    ring->events[write % ring->events.size()] = *event;
+    ring->write.store(write + 1, std::memory_order_release);
+}
+
+bool PopInput(InputRing *ring, InputEvent *event) {
+    const Uint64 read = ring->read.load(std::memory_order_relaxed);
+
+    if (read == ring->write.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    *event = ring->events[read % ring->events.size()];
+    ring->read.store(read + 1, std::memory_order_release);
+    return true;
+}
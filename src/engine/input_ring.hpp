@@ -0,0 +1,29 @@
+#ifndef INPUT_RING_HPP
+#define INPUT_RING_HPP
+
+#include <atomic>
+#include <vector>
+
+typedef struct InputEvent {
+    Uint64 read_time;  // performance counter when the event was polled
+    double queue_ms;   // time the event waited in the SDL queue
+    Uint8 actions;     // pressed actions the event resolved to
+} InputEvent;
+
+// Presses in the order they were polled, until a tick takes them. One
+// thread puts presses in and one takes them out, without locks. When the
+// ring is full the new press is dropped and counted.
+typedef struct InputRing {
+    std::vector<InputEvent> events;  // ring of presses
+    std::atomic<Uint64> read;        // amount of presses taken
+    std::atomic<Uint64> write;       // amount of presses put in
+    Uint64 dropped;                  // presses that found the ring full
+} InputRing;
+
+void InitInputRing(InputRing *ring, size_t capacity);
+
+void PushInput(InputRing *ring, const InputEvent *event);
+
+bool PopInput(InputRing *ring, InputEvent *event);
+
+#endif  // INPUT_RING_HPP
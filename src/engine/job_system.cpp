@@ -0,0 +1,162 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+
+namespace {
+
+bool PopJob(JobQueue *queue, Job *job) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+
+    if (queue->jobs.empty()) {
+        return false;
+    }
+
+    *job = queue->jobs.back();
+    queue->jobs.pop_back();
+    return true;
+}
+
+bool StealJob(JobQueue *queue, Job *job) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+
+    if (queue->jobs.empty()) {
+        return false;
+    }
+
+    *job = queue->jobs.front();
+    queue->jobs.pop_front();
+    return true;
+}
+
+bool FindJob(JobSystem *system, int worker, Job *job) {
+    if (PopJob(system->queues[worker].get(), job)) {
+        return true;
+    }
+
+    // Victims are visited starting with the next worker, so thieves spread
+    // over the queues instead of all emptying the first one
+    const int worker_count = static_cast<int>(system->queues.size());
+
+    for (int i = 1; i < worker_count; i++) {
+        const int victim = (worker + i) % worker_count;
+
+        if (StealJob(system->queues[victim].get(), job)) {
+            system->steals.fetch_add(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RunJobs(JobSystem *system, int worker) {
+    Job job;
+
+    while (FindJob(system, worker, &job)) {
+        job.function(job.data, job.begin, job.end, worker);
+        system->pending.fetch_sub(1);
+    }
+}
+
+void RunWorker(JobSystem *system, int worker) {
+    Uint64 seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(system->mutex);
+            system->wake.wait(lock, [system, seen] {
+                return system->quit || system->generation != seen;
+            });
+
+            if (system->quit) {
+                return;
+            }
+
+            seen = system->generation;
+        }
+
+        RunJobs(system, worker);
+    }
+}
+
+}  // namespace
+
+void InitJobSystem(JobSystem *system, int thread_count) {
+    thread_count = std::max(1, thread_count);
+
+    system->generation = 0;
+    system->quit = false;
+    system->pending = 0;
+    system->steals = 0;
+
+    system->queues.clear();
+    for (int i = 0; i < thread_count; i++) {
+        system->queues.push_back(
+            std::unique_ptr<JobQueue>(new JobQueue()));
+    }
+
+    system->threads.clear();
+    for (int i = 1; i < thread_count; i++) {
+        system->threads.push_back(std::thread(RunWorker, system, i));
+    }
+}
+
+int JobWorkerCount(const JobSystem *system) {
+    return static_cast<int>(system->queues.size());
+}
+
+void ParallelFor(JobSystem *system, int count, int grain, JobFunction function,
+                 void *data) {
+    if (count <= 0) {
+        return;
+    }
+
+    /* Split the loop into jobs */
+    // The jobs are dealt to the queues in turn and idle workers steal the
+    // rest. Results only depend on the items, never on which worker ran
+    // them, as long as the function doesn't share state between items.
+    grain = std::max(1, grain);
+    const int job_count = (count + grain - 1) / grain;
+    const int worker_count = JobWorkerCount(system);
+
+    system->pending = job_count;
+
+    for (int i = 0; i < job_count; i++) {
+        const Job job = {function, data, i * grain,
+                         std::min(count, (i + 1) * grain)};
+        JobQueue *queue = system->queues[i % worker_count].get();
+
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.push_back(job);
+    }
+
+    if (worker_count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(system->mutex);
+            system->generation += 1;
+        }
+        system->wake.notify_all();
+    }
+
+    /* The caller works too, then waits for the stolen jobs */
+    RunJobs(system, 0);
+
+    while (system->pending.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+void FreeJobSystem(JobSystem *system) {
+    {
+        std::lock_guard<std::mutex> lock(system->mutex);
+        system->quit = true;
+    }
+    system->wake.notify_all();
+
+    for (std::thread &thread : system->threads) {
+        thread.join();
+    }
+
+    system->threads.clear();
+    system->queues.clear();
+}
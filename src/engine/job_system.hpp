@@ -0,0 +1,50 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs the items [begin, end) of a parallel loop on the given worker
+typedef void (*JobFunction)(void *data, int begin, int end, int worker);
+
+typedef struct Job {
+    JobFunction function;  // function running the items
+    void *data;            // argument of the function
+    int begin;             // first item
+    int end;               // one past the last item
+} Job;
+
+// The owner takes jobs from the back, thieves steal from the front
+typedef struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+} JobQueue;
+
+// Worker 0 is the thread calling ParallelFor, the others are threads of the
+// system that sleep while there's no work
+typedef struct JobSystem {
+    std::vector<std::thread> threads;               // workers 1 and up
+    std::vector<std::unique_ptr<JobQueue>> queues;  // queue per worker
+    std::mutex mutex;                               // guards generation, quit
+    std::condition_variable wake;                   // new loop or quitting
+    Uint64 generation;                              // amount of loops started
+    bool quit;                                      // workers return when set
+    std::atomic<int> pending;                       // jobs left in the loop
+    std::atomic<Uint64> steals;                     // jobs run by a thief
+} JobSystem;
+
+void InitJobSystem(JobSystem *system, int thread_count);
+
+int JobWorkerCount(const JobSystem *system);
+
+void ParallelFor(JobSystem *system, int count, int grain, JobFunction function,
+                 void *data);
+
+void FreeJobSystem(JobSystem *system);
+
+#endif  // JOB_SYSTEM_HPP
@@ -0,0 +1,81 @@
+#include "level.hpp"
+
+#include <climits>
+#include <cstring>
+
+bool LoadLevel(Level *level, const char *path) {
+    level->header = NULL;
+    level->objects = NULL;
+    level->object_count = 0;
+
+    if (!MapFile(&level->file, path)) {
+        return false;
+    }
+
+    const Uint8 *data = level->file.data;
+    const size_t size = level->file.size;
+
+    /* Header */
+    if (size < sizeof(LevelHeader)) {
+        FreeLevel(level);
+        SDL_SetError("%s is too small to be a level", path);
+        return false;
+    }
+
+    const LevelHeader *header = reinterpret_cast<const LevelHeader *>(data);
+
+    if (std::memcmp(header->magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) != 0 ||
+        header->version != LEVEL_VERSION) {
+        FreeLevel(level);
+        SDL_SetError("%s is not a version %u level", path, LEVEL_VERSION);
+        return false;
+    }
+
+    if (header->tile_size <= 0 || header->columns <= 0 || header->rows <= 0) {
+        FreeLevel(level);
+        SDL_SetError("%s has an empty tile grid", path);
+        return false;
+    }
+
+    // The size of the level in pixels and the object count are kept in ints
+    if (header->columns > INT_MAX / header->tile_size ||
+        header->rows > INT_MAX / header->tile_size ||
+        header->object_count > static_cast<Uint32>(INT_MAX)) {
+        FreeLevel(level);
+        SDL_SetError("%s is too large", path);
+        return false;
+    }
+
+    /* Cells and objects */
+    const Uint64 cells_size = LevelCellsSize(header->columns, header->rows);
+    const Uint64 objects_size =
+        static_cast<Uint64>(header->object_count) * sizeof(LevelObject);
+
+    if (sizeof(LevelHeader) + cells_size + objects_size > size) {
+        FreeLevel(level);
+        SDL_SetError("%s is truncated", path);
+        return false;
+    }
+
+    const Uint8 *cells = data + sizeof(LevelHeader);
+
+    level->header = header;
+    level->objects = reinterpret_cast<const LevelObject *>(cells + cells_size);
+    level->object_count = static_cast<int>(header->object_count);
+    level->width = header->columns * header->tile_size;
+    level->height = header->rows * header->tile_size;
+
+    ViewTileMap(&level->tilemap, header->columns, header->rows,
+                header->tile_size, cells);
+    MergeTileColliders(&level->tilemap);
+
+    return true;
+}
+
+void FreeLevel(Level *level) {
+    UnmapFile(&level->file);
+    level->header = NULL;
+    level->objects = NULL;
+    level->object_count = 0;
+    ViewTileMap(&level->tilemap, 0, 0, 0, NULL);
+}
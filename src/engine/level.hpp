@@ -0,0 +1,22 @@
+#ifndef LEVEL_HPP
+#define LEVEL_HPP
+
+#include "engine/level_format.hpp"
+#include "mapped_file.hpp"
+#include "tilemap.hpp"
+
+typedef struct Level {
+    MappedFile file;             // the level file mapped into memory
+    const LevelHeader *header;   // header at the start of the file
+    TileMap tilemap;             // tiles, viewed in place in the file
+    const LevelObject *objects;  // off-grid objects, viewed in place
+    int object_count;            // amount of off-grid objects
+    int width;                   // width of the level in pixels
+    int height;                  // height of the level in pixels
+} Level;
+
+bool LoadLevel(Level *level, const char *path);
+
+void FreeLevel(Level *level);
+
+#endif  // LEVEL_HPP
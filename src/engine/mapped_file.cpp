@@ -0,0 +1,70 @@
+#include "mapped_file.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+bool MapFile(MappedFile *file, const char *path) {
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = false;
+
+#ifdef HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        SDL_SetError("Couldn't open %s", path);
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0) {
+        close(fd);
+        SDL_SetError("Couldn't read the size of %s", path);
+        return false;
+    }
+
+    void *data = mmap(NULL, static_cast<size_t>(file_stat.st_size), PROT_READ,
+                      MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps its own reference to the file
+
+    if (data == MAP_FAILED) {
+        SDL_SetError("Couldn't map %s", path);
+        return false;
+    }
+
+    file->data = static_cast<const Uint8 *>(data);
+    file->size = static_cast<size_t>(file_stat.st_size);
+    file->mapped = true;
+#else
+    // Fall back to reading the whole file where mmap is not available
+    void *data = SDL_LoadFile(path, &file->size);
+    if (data == NULL) {
+        return false;
+    }
+    file->data = static_cast<const Uint8 *>(data);
+#endif
+
+    return true;
+}
+
+void UnmapFile(MappedFile *file) {
+    if (file->data == NULL) {
+        return;
+    }
+
+#ifdef HAVE_MMAP
+    if (file->mapped) {
+        munmap(const_cast<Uint8 *>(file->data), file->size);
+    }
+#else
+    SDL_free(const_cast<Uint8 *>(file->data));
+#endif
+
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = false;
+}
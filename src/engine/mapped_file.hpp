@@ -0,0 +1,16 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+
+typedef struct MappedFile {
+    const Uint8 *data;  // contents of the file
+    size_t size;        // size of the file in bytes
+    bool mapped;        // data is a memory mapping rather than a copy
+} MappedFile;
+
+bool MapFile(MappedFile *file, const char *path);
+
+void UnmapFile(MappedFile *file);
+
+#endif  // MAPPED_FILE_HPP
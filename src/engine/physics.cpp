@@ -1,16 +1,81 @@
 #include "physics.hpp"
 
-void Gravity(Player *player) { player->dstrect.y += player->accel; }
+#include <algorithm>
+
+Sint32 ToFixed(int pixels) { return static_cast<Sint32>(pixels) * FIXED_ONE; }
+
+// Rounds towards negative infinity, so a body partly left of a pixel is
+// drawn in it
+int ToPixels(Sint32 fixed) {
+    return static_cast<int>(fixed >= 0 ? fixed / FIXED_ONE
+                                       : (fixed - FIXED_ONE + 1) / FIXED_ONE);
+}
+
+Sint32 FallStep(Sint32 *vy, int tick_rate) {
+    /* Constant acceleration up to the terminal velocity */
+    const Sint32 max_fall = ToFixed(MAX_FALL_SPEED);
+    const Sint32 velocity =
+        std::min(max_fall, *vy + ToFixed(GRAVITY) / tick_rate);
+
+    // Distance under constant acceleration is the average velocity over the
+    // tick, which is exact however many ticks a second are simulated
+    const Sint32 distance = (*vy + velocity) / (2 * tick_rate);
+    *vy = velocity;
+
+    return distance;
+}
+
+void Gravity(Player *player, int tick_rate) {
+    PhysicsBody *body = &player->body;
+    body->y += FallStep(&body->vy, tick_rate);
+
+    player->dstrect.y = ToPixels(body->y);
+}
 
 void JumpPhysics(Player *player, MotionState *motion_state) {
     /* Jump physics */
     if (motion_state->jump) {
-        player->dstrect.y -= player->accel * 2;
-        motion_state->jump_frames += 1;
+        // Impulse, gravity slows the jump down afterwards
+        player->body.vy = -ToFixed(player->jump_speed);
+        motion_state->jump = false;
     }
 
-    if (motion_state->jump_frames == 15) {
-        motion_state->jump = false;
-        motion_state->jump_frames = 0;
+    if (motion_state->drop) {
+        // One pixel below the top of the platform is enough for it to no
+        // longer catch the player
+        player->body.y += FIXED_ONE;
+        player->dstrect.y = ToPixels(player->body.y);
+        motion_state->drop = false;
+    }
+}
+
+void HorizontalMotion(Player *player, int tick_rate) {
+    PhysicsBody *body = &player->body;
+
+    // The part of the velocity that doesn't divide into the tick is carried
+    // to the next one, so a second of ticks covers the whole velocity
+    const Sint32 motion = body->vx + body->x_rest;
+    body->x += motion / tick_rate;
+    body->x_rest = motion % tick_rate;
+
+    player->dstrect.x = ToPixels(body->x);
+}
+
+void PlaceBody(Player *player) {
+    /* Move the body to where the player rectangle was put */
+    PhysicsBody *body = &player->body;
+
+    if (player->dstrect.x != ToPixels(body->x)) {
+        body->x = ToFixed(player->dstrect.x);
+        body->vx = 0;
+        body->x_rest = 0;
+    }
+
+    // Landing or standing stops the fall, even when the sub-pixel motion
+    // hasn't reached the next pixel yet
+    if (player->dstrect.y != ToPixels(body->y) ||
+        (player->collision_state.on_the_floor && body->vy > 0)) {
+        body->y = ToFixed(player->dstrect.y);
+        body->vy = 0;
     }
 }
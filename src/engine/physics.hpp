@@ -4,7 +4,27 @@
 #include "engine/entities.hpp"
 #include "physics.hpp"
 
-void Gravity(Player *player);
+/* Fixed-point */
+// Positions and velocities have 8 fractional bits, 1/256 of a pixel
+constexpr int FIXED_SHIFT = 8;
+constexpr Sint32 FIXED_ONE = 1 << FIXED_SHIFT;
+
+/* Kinematics */
+// Per second, so the motion doesn't depend on the tick rate. A jump rises
+// 60 pixels in a quarter of a second.
+constexpr int GRAVITY = 1920;           // downward acceleration in pixels/s^2
+constexpr int MAX_FALL_SPEED = 480;     // terminal velocity in pixels/s
+constexpr int PLAYER_SPEED = 120;       // horizontal velocity in pixels/s
+constexpr int PLAYER_JUMP_SPEED = 480;  // upward velocity of a jump in pixels/s
+
+Sint32 ToFixed(int pixels);
+int ToPixels(Sint32 fixed);
+
+Sint32 FallStep(Sint32 *vy, int tick_rate);
+
+void Gravity(Player *player, int tick_rate);
 void JumpPhysics(Player *player, MotionState *motion_state);
+void HorizontalMotion(Player *player, int tick_rate);
+void PlaceBody(Player *player);
 
 #endif  // PHYSICS_HPP
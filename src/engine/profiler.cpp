@@ -0,0 +1,163 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+namespace {
+
+std::atomic<Uint32> next_thread(0);
+
+// Threads are numbered in the order they record their first event
+Uint32 ThreadIndex() {
+    static thread_local Uint32 index = next_thread.fetch_add(1);
+    return index;
+}
+
+double Microseconds(const Profiler *profiler, Uint64 counter) {
+    return static_cast<double>(counter - profiler->origin) * 1e6 /
+           static_cast<double>(profiler->frequency);
+}
+
+}  // namespace
+
+ProfileScope::ProfileScope(Profiler *profiler, const char *name)
+    : profiler(profiler),
+      name(name),
+      start(profiler != NULL ? SDL_GetPerformanceCounter() : 0) {}
+
+ProfileScope::~ProfileScope() {
+    if (profiler != NULL) {
+        RecordProfileEvent(profiler, name, start, SDL_GetPerformanceCounter());
+    }
+}
+
+void InitProfiler(Profiler *profiler, size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    profiler->events.assign(size, ProfileEvent());
+    profiler->sequence = std::vector<std::atomic<Uint64>>(size);
+    for (std::atomic<Uint64> &sequence : profiler->sequence) {
+        sequence = 0;
+    }
+
+    profiler->mask = size - 1;
+    profiler->head = 0;
+    profiler->frame = 0;
+    profiler->origin = SDL_GetPerformanceCounter();
+    profiler->frequency = SDL_GetPerformanceFrequency();
+
+    // The thread that owns the profiler is thread 0 in the traces
+    ThreadIndex();
+}
+
+void RecordProfileEvent(Profiler *profiler, const char *name, Uint64 start,
+                        Uint64 end) {
+    const Uint64 index = profiler->head.fetch_add(1, std::memory_order_relaxed);
+    const Uint64 slot = index & profiler->mask;
+
+    // Mark the slot as being written, then publish it once it is complete
+    profiler->sequence[slot].store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ProfileEvent *event = &profiler->events[slot];
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    event->thread = ThreadIndex();
+    event->frame = profiler->frame.load(std::memory_order_relaxed);
+
+    profiler->sequence[slot].store(index + 1, std::memory_order_release);
+}
+
+void NextProfileFrame(Profiler *profiler) { profiler->frame.fetch_add(1); }
+
+size_t ReadProfileEvents(const Profiler *profiler, size_t max_events,
+                         std::vector<ProfileEvent> *events) {
+    events->clear();
+
+    const Uint64 head = profiler->head.load(std::memory_order_acquire);
+    const Uint64 count =
+        std::min<Uint64>(std::min<Uint64>(head, profiler->mask + 1),
+                         max_events);
+
+    /* Oldest to newest */
+    for (Uint64 index = head - count; index < head; index++) {
+        const Uint64 slot = index & profiler->mask;
+
+        if (profiler->sequence[slot].load(std::memory_order_acquire) !=
+            index + 1) {
+            continue;  // not published yet or already overwritten
+        }
+
+        const ProfileEvent event = profiler->events[slot];
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (profiler->sequence[slot].load(std::memory_order_relaxed) ==
+            index + 1) {
+            events->push_back(event);
+        }
+    }
+
+    return events->size();
+}
+
+double ProfileMilliseconds(const Profiler *profiler, Uint64 counts) {
+    return static_cast<double>(counts) * 1000.0 /
+           static_cast<double>(profiler->frequency);
+}
+
+bool WriteChromeTrace(const Profiler *profiler, const char *path) {
+    std::ofstream file(path);
+    if (!file) {
+        SDL_SetError("couldn't create %s", path);
+        return false;
+    }
+
+    std::vector<ProfileEvent> events;
+    ReadProfileEvents(profiler, profiler->events.size(), &events);
+
+    /* Chrome trace_event format */
+    // Complete events ("X") with their start and duration in microseconds,
+    // which chrome://tracing and Perfetto load directly
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << "{\"traceEvents\":[\n";
+
+    std::set<Uint32> threads;
+    bool first = true;
+
+    for (const ProfileEvent &event : events) {
+        const double start = Microseconds(profiler, event.start);
+        const double end = Microseconds(profiler, event.end);
+
+        file << (first ? "" : ",\n") << "{\"name\":\"" << event.name
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << start << ",\"dur\":" << end - start
+             << ",\"args\":{\"frame\":" << event.frame << "}}";
+
+        threads.insert(event.thread);
+        first = false;
+    }
+
+    // Thread names
+    for (Uint32 thread : threads) {
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+             << thread << ",\"args\":{\"name\":\""
+             << (thread == 0 ? "main" : "worker") << " " << thread << "\"}}";
+        first = false;
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!file) {
+        SDL_SetError("couldn't write %s", path);
+        return false;
+    }
+
+    return true;
+}
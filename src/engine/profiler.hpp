@@ -0,0 +1,52 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <vector>
+
+typedef struct ProfileEvent {
+    const char *name;  // phase name, a string literal
+    Uint64 start;      // performance counter at the start of the phase
+    Uint64 end;        // performance counter at the end of the phase
+    Uint32 thread;     // profiler thread index of the recording thread
+    Uint32 frame;      // frame the phase ran in
+} ProfileEvent;
+
+// Events of every thread go into one ring without locks. A writer claims a
+// slot by bumping the head and publishes the event with the sequence of the
+// slot, so a reader skips slots that are being overwritten.
+typedef struct Profiler {
+    std::vector<ProfileEvent> events;           // ring of recent events
+    std::vector<std::atomic<Uint64>> sequence;  // index + 1 of each slot
+    Uint64 mask;                                // capacity minus one
+    std::atomic<Uint64> head;                   // amount of events written
+    std::atomic<Uint32> frame;                  // current frame
+    Uint64 origin;                              // counter at the start
+    Uint64 frequency;                           // counter ticks per second
+} Profiler;
+
+// Times the enclosing scope, does nothing without a profiler
+typedef struct ProfileScope {
+    ProfileScope(Profiler *profiler, const char *name);
+    ~ProfileScope();
+
+    Profiler *profiler;
+    const char *name;
+    Uint64 start;
+} ProfileScope;
+
+void InitProfiler(Profiler *profiler, size_t capacity);
+
+void RecordProfileEvent(Profiler *profiler, const char *name, Uint64 start,
+                        Uint64 end);
+
+void NextProfileFrame(Profiler *profiler);
+
+size_t ReadProfileEvents(const Profiler *profiler, size_t max_events,
+                         std::vector<ProfileEvent> *events);
+
+double ProfileMilliseconds(const Profiler *profiler, Uint64 counts);
+
+bool WriteChromeTrace(const Profiler *profiler, const char *path);
+
+#endif  // PROFILER_HPP
@@ -0,0 +1,60 @@
+#include "render_snapshot.hpp"
+
+#include <algorithm>
+
+#include "frame_clock.hpp"
+
+namespace {
+
+constexpr Uint8 SNAPSHOT_INDEX = 0x3;  // bits of the snapshot index
+constexpr Uint8 SNAPSHOT_FRESH = 0x4;  // the middle snapshot is unread
+
+}  // namespace
+
+void InitSnapshotBuffer(SnapshotBuffer *buffer,
+                        const RenderSnapshot *snapshot) {
+    for (RenderSnapshot &slot : buffer->snapshots) {
+        slot = *snapshot;
+    }
+
+    buffer->back = 0;
+    buffer->middle.store(1);
+    buffer->front = 2;
+}
+
+RenderSnapshot *BackSnapshot(SnapshotBuffer *buffer) {
+    return &buffer->snapshots[buffer->back];
+}
+
+void PublishSnapshot(SnapshotBuffer *buffer) {
+    // Releases the filled snapshot and takes the old middle one to fill
+    // next, an unread middle snapshot is replaced by the newer one
+    const Uint8 middle = buffer->middle.exchange(
+        buffer->back | SNAPSHOT_FRESH, std::memory_order_acq_rel);
+    buffer->back = middle & SNAPSHOT_INDEX;
+}
+
+const RenderSnapshot *ReadSnapshot(SnapshotBuffer *buffer, bool *fresh) {
+    *fresh = (buffer->middle.load(std::memory_order_relaxed) &
+              SNAPSHOT_FRESH) != 0;
+
+    if (*fresh) {
+        const Uint8 middle =
+            buffer->middle.exchange(buffer->front, std::memory_order_acq_rel);
+        buffer->front = middle & SNAPSHOT_INDEX;
+    }
+
+    return &buffer->snapshots[buffer->front];
+}
+
+SDL_Rect SnapshotPlayerRect(const RenderSnapshot *snapshot, Uint64 now,
+                            Uint64 tick_counts) {
+    // Draw the player between the last two simulated states, by how far
+    // the next tick is
+    const double elapsed =
+        now > snapshot->time ? static_cast<double>(now - snapshot->time) : 0.0;
+    const double alpha =
+        std::min(1.0, elapsed / static_cast<double>(tick_counts));
+
+    return InterpolateRect(snapshot->previous, snapshot->current, alpha);
+}
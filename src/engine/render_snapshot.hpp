@@ -0,0 +1,46 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+
+#include <atomic>
+
+#include "input_ring.hpp"
+
+constexpr int SNAPSHOT_PRESSES = 4;  // presses kept per snapshot
+
+// What the renderer needs of the last tick, copied out of the simulation.
+// The tiles and objects never move, so the player is the only sprite.
+typedef struct RenderSnapshot {
+    SDL_Rect previous;  // player rectangle before the last tick
+    SDL_Rect current;   // player rectangle after the last tick
+    Uint64 time;        // performance counter the last tick was due at
+    Uint32 tick;        // amount of ticks simulated
+    bool idle;          // the last tick changed nothing, without input
+    int press_count;    // presses the last tick simulated
+    InputEvent presses[SNAPSHOT_PRESSES];
+} RenderSnapshot;
+
+// Triple buffer between the simulation and the renderer. The simulation
+// fills the back snapshot while the renderer reads the front one, and
+// publishing swaps the back with the middle one in a single exchange, so
+// neither side ever waits for the other. The renderer only swaps the front
+// with the middle when it holds a snapshot it hasn't read.
+typedef struct SnapshotBuffer {
+    RenderSnapshot snapshots[3];
+    std::atomic<Uint8> middle;  // latest snapshot, SNAPSHOT_FRESH if unread
+    Uint8 back;                 // snapshot the simulation fills
+    Uint8 front;                // snapshot the renderer reads
+} SnapshotBuffer;
+
+void InitSnapshotBuffer(SnapshotBuffer *buffer,
+                        const RenderSnapshot *snapshot);
+
+RenderSnapshot *BackSnapshot(SnapshotBuffer *buffer);
+
+void PublishSnapshot(SnapshotBuffer *buffer);
+
+const RenderSnapshot *ReadSnapshot(SnapshotBuffer *buffer, bool *fresh);
+
+SDL_Rect SnapshotPlayerRect(const RenderSnapshot *snapshot, Uint64 now,
+                            Uint64 tick_counts);
+
+#endif  // RENDER_SNAPSHOT_HPP
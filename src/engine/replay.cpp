@@ -0,0 +1,104 @@
+#include "replay.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "mapped_file.hpp"
+
+namespace {
+
+constexpr Uint64 FNV_OFFSET = 14695981039346656037ULL;
+constexpr Uint64 FNV_PRIME = 1099511628211ULL;
+
+Uint64 HashValue(Uint64 hash, Sint32 value) {
+    const Uint32 bits = static_cast<Uint32>(value);
+
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ ((bits >> (8 * i)) & 0xFF)) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+}  // namespace
+
+void InitInputRecording(InputRecording *recording, int tick_rate) {
+    recording->tick_rate = tick_rate;
+    recording->actions.clear();
+}
+
+bool SaveInputRecording(const InputRecording *recording, const char *path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        SDL_SetError("couldn't create %s", path);
+        return false;
+    }
+
+    ReplayHeader header;
+    std::memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    header.version = REPLAY_VERSION;
+    header.tick_rate = static_cast<std::uint32_t>(recording->tick_rate);
+    header.tick_count = static_cast<std::uint32_t>(recording->actions.size());
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(recording->actions.data()),
+               static_cast<std::streamsize>(recording->actions.size()));
+
+    if (!file) {
+        SDL_SetError("couldn't write %s", path);
+        return false;
+    }
+
+    return true;
+}
+
+bool LoadInputRecording(InputRecording *recording, const char *path) {
+    MappedFile file;
+
+    if (!MapFile(&file, path)) {
+        return false;
+    }
+
+    const ReplayHeader *header =
+        reinterpret_cast<const ReplayHeader *>(file.data);
+
+    if (file.size < sizeof(ReplayHeader) ||
+        std::memcmp(header->magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        header->version != REPLAY_VERSION || header->tick_rate == 0 ||
+        sizeof(ReplayHeader) + header->tick_count > file.size) {
+        UnmapFile(&file);
+        SDL_SetError("%s is not a version %u input recording", path,
+                     REPLAY_VERSION);
+        return false;
+    }
+
+    const Uint8 *actions = file.data + sizeof(ReplayHeader);
+    recording->tick_rate = static_cast<int>(header->tick_rate);
+    recording->actions.assign(actions, actions + header->tick_count);
+
+    UnmapFile(&file);
+
+    return true;
+}
+
+Uint64 HashPlayerState(const Player *player) {
+    /* FNV-1a over the simulated state */
+    // Field by field, so padding and the texture don't change the hash
+    Uint64 hash = FNV_OFFSET;
+
+    hash = HashValue(hash, player->dstrect.x);
+    hash = HashValue(hash, player->dstrect.y);
+    hash = HashValue(hash, player->dstrect.w);
+    hash = HashValue(hash, player->dstrect.h);
+    hash = HashValue(hash, player->body.x);
+    hash = HashValue(hash, player->body.y);
+    hash = HashValue(hash, player->body.vx);
+    hash = HashValue(hash, player->body.vy);
+    hash = HashValue(hash, player->body.x_rest);
+    hash = HashValue(hash, player->collision_state.on_the_floor);
+    hash = HashValue(hash, player->collision_state.on_the_platform);
+    hash = HashValue(hash, player->motion_state.jump);
+    hash = HashValue(hash, player->motion_state.drop);
+
+    return hash;
+}
@@ -0,0 +1,23 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <vector>
+
+#include "engine/entities.hpp"
+#include "engine/replay_format.hpp"
+
+// Actions of every tick of a run, enough to simulate it again
+typedef struct InputRecording {
+    int tick_rate;               // simulation ticks per second of the run
+    std::vector<Uint8> actions;  // Action bits of each tick
+} InputRecording;
+
+void InitInputRecording(InputRecording *recording, int tick_rate);
+
+bool SaveInputRecording(const InputRecording *recording, const char *path);
+
+bool LoadInputRecording(InputRecording *recording, const char *path);
+
+Uint64 HashPlayerState(const Player *player);
+
+#endif  // REPLAY_HPP
@@ -0,0 +1,124 @@
+#include "simulation.hpp"
+
+#include "actions.hpp"
+#include "collision.hpp"
+#include "physics.hpp"
+
+namespace {
+
+// Moves the player for the tick without collisions and returns where the
+// move starts, the move is swept from there
+SDL_Rect MovePlayer(Player *player, int tick_rate, Profiler *profiler) {
+    /* Jump physics */
+    {
+        ProfileScope scope(profiler, "JumpPhysics");
+        JumpPhysics(player, &player->motion_state);
+    }
+
+    const SDL_Rect start = player->dstrect;
+
+    /* Gravity */
+    {
+        ProfileScope scope(profiler, "Gravity");
+        Gravity(player, tick_rate);
+    }
+
+    /* Walking */
+    {
+        ProfileScope scope(profiler, "HorizontalMotion");
+        HorizontalMotion(player, tick_rate);
+    }
+
+    return start;
+}
+
+}  // namespace
+
+void PlayerBoundary(Player *player, int level_width, int level_height) {
+    /* Player boundaries */
+    // left boundary
+    if (player->dstrect.x < 0) {
+        player->dstrect.x = 0;
+    }
+    // right boundary
+    if (player->dstrect.x + player->dstrect.w > level_width) {
+        player->dstrect.x = level_width - player->dstrect.w;
+    }
+    // bottom boundary
+    if (player->dstrect.y + player->dstrect.h > level_height) {
+        player->dstrect.y = level_height - player->dstrect.h;
+    }
+    // top boundary
+    if (player->dstrect.y < 0) {
+        player->dstrect.y = 0;
+    }
+
+    // Stop the body at the boundary too
+    PlaceBody(player);
+}
+
+void SimulateTick(Player *player, Uint8 actions, const Level *level,
+                  SpatialHash *objects, int tick_rate, Profiler *profiler) {
+    StepWorld(player, actions, level, objects, &objects->scratch, tick_rate,
+              profiler);
+
+    // The sweep of the game's player is counted in the broadphase stats
+    objects->stats.queries += 1;
+    objects->stats.objects += objects->colliders.x.size();
+    objects->stats.candidates += objects->scratch.candidates.size();
+}
+
+void StepWorld(Player *player, Uint8 actions, const Level *level,
+               const SpatialHash *objects, QueryScratch *scratch,
+               int tick_rate, Profiler *profiler) {
+    /* Actions of the tick */
+    {
+        ProfileScope scope(profiler, "ApplyActions");
+        ApplyActions(player, actions);
+    }
+
+    /* Gravity, jump physics and walking */
+    const SDL_Rect start = MovePlayer(player, tick_rate, profiler);
+
+    /* Player block and platform collisons */
+    // The colliders are only read, so threads sharing them can step their
+    // own players with their own scratch buffers
+    {
+        ProfileScope scope(profiler, "SweepPlayer");
+        player->dstrect =
+            SweepRect(start, player->dstrect, &level->tilemap, objects,
+                      scratch, &player->collision_state);
+        PlaceBody(player);
+    }
+
+    /* Player boundaries */
+    // Clamped after the sweep, so the position the tick ends at, which is
+    // drawn and hashed, never leaves the level
+    {
+        ProfileScope scope(profiler, "PlayerBoundary");
+        PlayerBoundary(player, level->width, level->height);
+    }
+}
+
+bool ResimulateFromTick(SnapshotRing *ring, Uint32 tick, Player *player,
+                        const Level *level, SpatialHash *objects,
+                        int tick_rate) {
+    /* Rollback */
+    // Go back to the state before the tick and simulate every tick after it
+    // again with the stored actions, which may have been corrected since
+    if (!HasTick(ring, tick)) {
+        return false;
+    }
+
+    const Uint32 end = ring->next;
+    RestoreSnapshot(player, TickSnapshot(ring, tick));
+    ring->next = tick;
+
+    while (ring->next != end) {
+        const Uint8 actions = TickActions(ring, ring->next);
+        PushTick(ring, player, actions);
+        SimulateTick(player, actions, level, objects, tick_rate, NULL);
+    }
+
+    return true;
+}
@@ -0,0 +1,25 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "broadphase.hpp"
+#include "engine/entities.hpp"
+#include "level.hpp"
+#include "profiler.hpp"
+#include "snapshot.hpp"
+
+void PlayerBoundary(Player *player, int level_width, int level_height);
+
+void SimulateTick(Player *player, Uint8 actions, const Level *level,
+                  SpatialHash *objects, int tick_rate, Profiler *profiler);
+
+// The one tick of the player, SimulateTick steps the game's player with
+// the scratch buffers of the hash
+void StepWorld(Player *player, Uint8 actions, const Level *level,
+               const SpatialHash *objects, QueryScratch *scratch,
+               int tick_rate, Profiler *profiler);
+
+bool ResimulateFromTick(SnapshotRing *ring, Uint32 tick, Player *player,
+                        const Level *level, SpatialHash *objects,
+                        int tick_rate);
+
+#endif  // SIMULATION_HPP
@@ -0,0 +1,157 @@
+#include "simulation_thread.hpp"
+
+#include <chrono>
+
+#include "actions.hpp"
+#include "frame_clock.hpp"
+#include "simulation.hpp"
+
+namespace {
+
+constexpr int MAX_TICKS = 5;          // bound on catch up ticks per wake
+constexpr int IDLE_TIMEOUT_MS = 250;  // longest wait while nothing moves
+
+void RunSimulation(SimulationThread *sim) {
+    FrameClock clock;
+    InitFrameClock(&clock, sim->tick_rate, sim->tick_rate);
+
+    Player *player = sim->player;
+    Uint32 tick = 0;    // amount of ticks simulated
+    bool idle = false;  // the last tick changed nothing, without input
+
+    while (!sim->quit.load()) {
+        // Input that arrives from here on wakes the thread from idling
+        {
+            std::lock_guard<std::mutex> lock(sim->mutex);
+            sim->woken = false;
+        }
+
+        const int ticks = AdvanceFrameClock(&clock, MAX_TICKS, NULL);
+
+        for (int i = 0; i < ticks; i++) {
+            ProfileScope scope(sim->profiler, "Simulate");
+            RenderSnapshot *snapshot = BackSnapshot(sim->snapshots);
+
+            // Presses are simulated once, on the first tick after them
+            Uint8 actions = sim->held.load();
+            InputEvent press;
+            snapshot->press_count = 0;
+
+            while (PopInput(sim->input, &press)) {
+                actions |= press.actions;
+
+                if (snapshot->press_count < SNAPSHOT_PRESSES) {
+                    snapshot->presses[snapshot->press_count] = press;
+                    snapshot->press_count += 1;
+                }
+            }
+
+            snapshot->previous = player->dstrect;
+            const bool was_idle = idle;
+            idle = false;
+
+            // Rewound ticks are dropped from the recording too, so it
+            // still leads to the state on the screen
+            if ((actions & ACTION_REWIND) != 0) {
+                if (PopTick(sim->history, player) && sim->record != NULL) {
+                    sim->record->actions.pop_back();
+                }
+            } else {
+                if (sim->record != NULL) {
+                    sim->record->actions.push_back(actions);
+                }
+
+                PushTick(sim->history, player, actions);
+                SimulateTick(player, actions, sim->level, sim->objects,
+                             sim->tick_rate, sim->profiler);
+
+                WorldSnapshot state;
+                SaveSnapshot(player, &state);
+                idle = actions == 0 &&
+                       SameSnapshot(TickSnapshot(sim->history,
+                                                 sim->history->next - 1),
+                                    &state);
+            }
+
+            // Another idle tick looks the same, so the renderer keeps
+            // waiting instead of drawing it
+            if (idle && was_idle && snapshot->press_count == 0) {
+                continue;
+            }
+
+            snapshot->current = player->dstrect;
+            snapshot->time = clock.previous - clock.accumulator;
+            snapshot->tick = ++tick;
+            snapshot->idle = idle;
+            PublishSnapshot(sim->snapshots);
+        }
+
+        /* Wait for the next tick */
+        // Idle ticks would all leave the state as it is, so an idle thread
+        // sleeps until input arrives and skips the time it slept
+        std::unique_lock<std::mutex> lock(sim->mutex);
+
+        if (idle) {
+            sim->wake.wait_for(
+                lock, std::chrono::milliseconds(IDLE_TIMEOUT_MS),
+                [sim] { return sim->woken || sim->quit.load(); });
+            ResumeFrameClock(&clock);
+        } else {
+            const Uint64 counts = CountsUntilNextTick(&clock);
+            sim->wake.wait_for(
+                lock,
+                std::chrono::microseconds(counts * 1000000 / clock.frequency),
+                [sim] { return sim->quit.load(); });
+        }
+    }
+}
+
+}  // namespace
+
+void StartSimulationThread(SimulationThread *sim, const Level *level,
+                           SpatialHash *objects, Player *player,
+                           SnapshotRing *history, InputRecording *record,
+                           InputRing *input, SnapshotBuffer *snapshots,
+                           int tick_rate, Profiler *profiler) {
+    sim->level = level;
+    sim->objects = objects;
+    sim->player = player;
+    sim->history = history;
+    sim->record = record;
+    sim->input = input;
+    sim->snapshots = snapshots;
+    sim->profiler = profiler;
+    sim->tick_rate = tick_rate;
+    sim->held.store(0);
+    sim->quit.store(false);
+    sim->woken = false;
+
+    sim->thread = std::thread(RunSimulation, sim);
+}
+
+void SendHeldActions(SimulationThread *sim, Uint8 held) {
+    // Presses are already in the ring, an idle thread only has to wake
+    // when there is something new to simulate
+    const bool pending =
+        sim->input->write.load() != sim->input->read.load();
+
+    if (sim->held.exchange(held) == held && !pending) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sim->mutex);
+    sim->woken = true;
+    sim->wake.notify_one();
+}
+
+void StopSimulationThread(SimulationThread *sim) {
+    {
+        std::lock_guard<std::mutex> lock(sim->mutex);
+        sim->quit.store(true);
+    }
+    sim->wake.notify_one();
+
+    if (sim->thread.joinable()) {
+        sim->thread.join();
+    }
+}
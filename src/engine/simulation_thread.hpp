@@ -0,0 +1,51 @@
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "broadphase.hpp"
+#include "engine/entities.hpp"
+#include "input_ring.hpp"
+#include "level.hpp"
+#include "profiler.hpp"
+#include "render_snapshot.hpp"
+#include "replay.hpp"
+#include "snapshot.hpp"
+
+// Ticks the simulation on its own thread at the tick rate and publishes a
+// render snapshot after every tick, so a slow present never holds back a
+// tick and a burst of ticks never holds back a frame. While it runs, the
+// thread owns the player, the colliders, the history and the recording.
+// The main thread only sends it input and reads the snapshots.
+typedef struct SimulationThread {
+    std::thread thread;
+    const Level *level;            // level being played
+    SpatialHash *objects;          // colliders off the tile grid
+    Player *player;                // player being simulated
+    SnapshotRing *history;         // state before the last ticks, to rewind
+    InputRecording *record;        // actions of every tick, or NULL
+    InputRing *input;              // presses not simulated yet
+    SnapshotBuffer *snapshots;     // snapshots for the renderer
+    Profiler *profiler;            // phase timers, or NULL
+    int tick_rate;                 // simulation ticks per second
+    std::atomic<Uint8> held;       // held actions, sampled by the main thread
+    std::atomic<bool> quit;        // the thread returns when set
+    std::mutex mutex;              // guards woken
+    std::condition_variable wake;  // input arrived or quitting
+    bool woken;                    // input arrived since the last ticks
+} SimulationThread;
+
+void StartSimulationThread(SimulationThread *sim, const Level *level,
+                           SpatialHash *objects, Player *player,
+                           SnapshotRing *history, InputRecording *record,
+                           InputRing *input, SnapshotBuffer *snapshots,
+                           int tick_rate, Profiler *profiler);
+
+void SendHeldActions(SimulationThread *sim, Uint8 held);
+
+void StopSimulationThread(SimulationThread *sim);
+
+#endif  // SIMULATION_THREAD_HPP
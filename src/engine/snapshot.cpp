@@ -0,0 +1,85 @@
+#include "snapshot.hpp"
+
+namespace {
+
+size_t Slot(const SnapshotRing *ring, Uint32 tick) {
+    return tick % ring->states.size();
+}
+
+}  // namespace
+
+void SaveSnapshot(const Player *player, WorldSnapshot *snapshot) {
+    snapshot->dstrect = player->dstrect;
+    snapshot->body = player->body;
+    snapshot->collision_state = player->collision_state;
+    snapshot->motion_state = player->motion_state;
+}
+
+void RestoreSnapshot(Player *player, const WorldSnapshot *snapshot) {
+    player->dstrect = snapshot->dstrect;
+    player->body = snapshot->body;
+    player->collision_state = snapshot->collision_state;
+    player->motion_state = snapshot->motion_state;
+}
+
+bool SameSnapshot(const WorldSnapshot *a, const WorldSnapshot *b) {
+    // Compared field by field, the padding of a snapshot is not copied
+    return a->dstrect.x == b->dstrect.x && a->dstrect.y == b->dstrect.y &&
+           a->dstrect.w == b->dstrect.w && a->dstrect.h == b->dstrect.h &&
+           a->body.x == b->body.x && a->body.y == b->body.y &&
+           a->body.vx == b->body.vx && a->body.vy == b->body.vy &&
+           a->body.x_rest == b->body.x_rest &&
+           a->collision_state.on_the_floor ==
+               b->collision_state.on_the_floor &&
+           a->collision_state.on_the_platform ==
+               b->collision_state.on_the_platform &&
+           a->motion_state.jump == b->motion_state.jump &&
+           a->motion_state.drop == b->motion_state.drop;
+}
+
+void InitSnapshotRing(SnapshotRing *ring, int capacity, Uint32 tick) {
+    ring->states.assign(capacity, WorldSnapshot());
+    ring->actions.assign(capacity, 0);
+    ring->first = tick;
+    ring->next = tick;
+}
+
+void PushTick(SnapshotRing *ring, const Player *player, Uint8 actions) {
+    /* Save the state before simulating the next tick */
+    const size_t slot = Slot(ring, ring->next);
+    SaveSnapshot(player, &ring->states[slot]);
+    ring->actions[slot] = actions;
+    ring->next += 1;
+
+    // The oldest tick is overwritten once the ring is full
+    if (ring->next - ring->first > ring->states.size()) {
+        ring->first += 1;
+    }
+}
+
+bool PopTick(SnapshotRing *ring, Player *player) {
+    /* Rewind the last simulated tick */
+    if (ring->next == ring->first) {
+        return false;
+    }
+
+    ring->next -= 1;
+    RestoreSnapshot(player, &ring->states[Slot(ring, ring->next)]);
+    return true;
+}
+
+bool HasTick(const SnapshotRing *ring, Uint32 tick) {
+    return tick - ring->first < ring->next - ring->first;
+}
+
+Uint8 TickActions(const SnapshotRing *ring, Uint32 tick) {
+    return ring->actions[Slot(ring, tick)];
+}
+
+void SetTickActions(SnapshotRing *ring, Uint32 tick, Uint8 actions) {
+    ring->actions[Slot(ring, tick)] = actions;
+}
+
+const WorldSnapshot *TickSnapshot(const SnapshotRing *ring, Uint32 tick) {
+    return &ring->states[Slot(ring, tick)];
+}
@@ -0,0 +1,50 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <type_traits>
+#include <vector>
+
+#include "engine/entities.hpp"
+
+// Everything a tick of the simulation changes, without pointers, so it is
+// saved and restored with a plain copy and can be sent or written as is
+typedef struct WorldSnapshot {
+    SDL_Rect dstrect;  // player rectangle in whole pixels
+    PhysicsBody body;  // sub-pixel position and velocity
+    CollisionState collision_state;
+    MotionState motion_state;
+} WorldSnapshot;
+
+static_assert(std::is_trivially_copyable<WorldSnapshot>::value,
+              "WorldSnapshot must be plain data");
+
+// State at the start of the last ticks and the actions they were simulated
+// with, enough to go back to any of them and simulate forward again
+typedef struct SnapshotRing {
+    std::vector<WorldSnapshot> states;  // state before each tick
+    std::vector<Uint8> actions;         // actions each tick was simulated with
+    Uint32 first;                       // oldest tick in the ring
+    Uint32 next;                        // tick that is simulated next
+} SnapshotRing;
+
+void SaveSnapshot(const Player *player, WorldSnapshot *snapshot);
+
+void RestoreSnapshot(Player *player, const WorldSnapshot *snapshot);
+
+bool SameSnapshot(const WorldSnapshot *a, const WorldSnapshot *b);
+
+void InitSnapshotRing(SnapshotRing *ring, int capacity, Uint32 tick);
+
+void PushTick(SnapshotRing *ring, const Player *player, Uint8 actions);
+
+bool PopTick(SnapshotRing *ring, Player *player);
+
+bool HasTick(const SnapshotRing *ring, Uint32 tick);
+
+Uint8 TickActions(const SnapshotRing *ring, Uint32 tick);
+
+void SetTickActions(SnapshotRing *ring, Uint32 tick, Uint8 actions);
+
+const WorldSnapshot *TickSnapshot(const SnapshotRing *ring, Uint32 tick);
+
+#endif  // SNAPSHOT_HPP
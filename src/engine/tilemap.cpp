@@ -0,0 +1,122 @@
+#include "tilemap.hpp"
+
+#include "broadphase.hpp"
+
+namespace {
+
+// Whether the tile can still start or grow a collider of the kind
+bool Mergeable(const TileMap *tilemap, int column, int row, Uint8 kind) {
+    return column < tilemap->columns && row < tilemap->rows &&
+           GetTile(tilemap, column, row) == kind &&
+           tilemap->collider_of[static_cast<size_t>(row) * tilemap->columns +
+                                column] == -1;
+}
+
+}  // namespace
+
+void InitTileMap(TileMap *tilemap, int columns, int rows, int tile_size) {
+    tilemap->columns = columns;
+    tilemap->rows = rows;
+    tilemap->tile_size = tile_size;
+    tilemap->storage.assign(static_cast<size_t>(columns) * rows, TILE_EMPTY);
+    tilemap->cells = tilemap->storage.data();
+    ClearEntities(&tilemap->colliders);
+    tilemap->collider_of.clear();
+}
+
+void ViewTileMap(TileMap *tilemap, int columns, int rows, int tile_size,
+                 const Uint8 *cells) {
+    tilemap->columns = columns;
+    tilemap->rows = rows;
+    tilemap->tile_size = tile_size;
+    tilemap->cells = cells;
+    tilemap->storage.clear();
+    ClearEntities(&tilemap->colliders);
+    tilemap->collider_of.clear();
+}
+
+void SetTile(TileMap *tilemap, int column, int row, Uint8 kind) {
+    if (column < 0 || column >= tilemap->columns || row < 0 ||
+        row >= tilemap->rows) {
+        return;
+    }
+
+    // Copy viewed cells before the first edit
+    const size_t size = static_cast<size_t>(tilemap->columns) * tilemap->rows;
+    if (tilemap->storage.size() != size) {
+        tilemap->storage.assign(tilemap->cells, tilemap->cells + size);
+        tilemap->cells = tilemap->storage.data();
+    }
+
+    tilemap->storage[static_cast<size_t>(row) * tilemap->columns + column] =
+        kind;
+}
+
+Uint8 GetTile(const TileMap *tilemap, int column, int row) {
+    if (column < 0 || column >= tilemap->columns || row < 0 ||
+        row >= tilemap->rows) {
+        return TILE_EMPTY;
+    }
+    return tilemap->cells[static_cast<size_t>(row) * tilemap->columns +
+                          column];
+}
+
+void MergeTileColliders(TileMap *tilemap) {
+    /* Greedy merge */
+    // From the top left, each tile not covered yet grows a collider right
+    // along its row and then down while the whole width below matches.
+    // Platforms only grow along the row, since every platform tile has a
+    // top the player can land on.
+    const int size = tilemap->tile_size;
+
+    ClearEntities(&tilemap->colliders);
+    tilemap->collider_of.assign(
+        static_cast<size_t>(tilemap->columns) * tilemap->rows, -1);
+
+    for (int row = 0; row < tilemap->rows; row++) {
+        for (int column = 0; column < tilemap->columns; column++) {
+            const Uint8 kind = GetTile(tilemap, column, row);
+
+            if (kind == TILE_EMPTY || !Mergeable(tilemap, column, row, kind)) {
+                continue;
+            }
+
+            int width = 1;
+            while (Mergeable(tilemap, column + width, row, kind)) {
+                width += 1;
+            }
+
+            int height = 1;
+            bool grows = kind == TILE_BLOCK;
+            while (grows) {
+                for (int i = 0; i < width && grows; i++) {
+                    grows = Mergeable(tilemap, column + i, row + height, kind);
+                }
+                height += grows ? 1 : 0;
+            }
+
+            const SDL_Rect rect = {column * size, row * size, width * size,
+                                   height * size};
+            const int index = AddEntity(
+                &tilemap->colliders, rect,
+                kind == TILE_BLOCK ? COLLIDER_BLOCK : COLLIDER_PLATFORM, 0);
+
+            for (int y = row; y < row + height; y++) {
+                for (int x = column; x < column + width; x++) {
+                    tilemap->collider_of[static_cast<size_t>(y) *
+                                             tilemap->columns +
+                                         x] = index;
+                }
+            }
+        }
+    }
+}
+
+int TileCollider(const TileMap *tilemap, int column, int row) {
+    if (column < 0 || column >= tilemap->columns || row < 0 ||
+        row >= tilemap->rows || tilemap->collider_of.empty()) {
+        return -1;
+    }
+    return tilemap->collider_of[static_cast<size_t>(row) * tilemap->columns +
+                                column];
+}
@@ -0,0 +1,40 @@
+#ifndef TILEMAP_HPP
+#define TILEMAP_HPP
+
+#include <vector>
+
+#include "entity_store.hpp"
+
+enum TileKind { TILE_EMPTY = 0, TILE_BLOCK = 1, TILE_PLATFORM = 2 };
+
+// The cells are either owned by the tilemap or viewed in place, for example
+// inside a mapped level file. Tilemaps are not copied since cells can point
+// into their own storage.
+//
+// Collision does not test tiles one by one. MergeTileColliders covers the
+// solid tiles with as few rectangles as it can once the tiles are placed,
+// and each cell keeps the index of the rectangle covering it.
+typedef struct TileMap {
+    int columns;                   // amount of tiles per row
+    int rows;                      // amount of tiles per column
+    int tile_size;                 // width and height of a tile in pixels
+    const Uint8 *cells;            // tile kinds in row major order
+    std::vector<Uint8> storage;    // owned cells, empty for a view
+    EntityStore colliders;         // merged tiles, by collider kind
+    std::vector<int> collider_of;  // collider covering each cell, or -1
+} TileMap;
+
+void InitTileMap(TileMap *tilemap, int columns, int rows, int tile_size);
+
+void ViewTileMap(TileMap *tilemap, int columns, int rows, int tile_size,
+                 const Uint8 *cells);
+
+void SetTile(TileMap *tilemap, int column, int row, Uint8 kind);
+
+Uint8 GetTile(const TileMap *tilemap, int column, int row);
+
+void MergeTileColliders(TileMap *tilemap);
+
+int TileCollider(const TileMap *tilemap, int column, int row);
+
+#endif  // TILEMAP_HPP
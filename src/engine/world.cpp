@@ -0,0 +1,67 @@
+#include "world.hpp"
+
+#include "physics.hpp"
+
+namespace {
+
+constexpr int PLAYER_WIDTH = 24;   // width of the player in pixels
+constexpr int PLAYER_HEIGHT = 24;  // height of the player in pixels
+
+}  // namespace
+
+Player CreatePlayer(const Level *level) {
+    return CreatePlayerAt(level->header->spawn_x, level->header->spawn_y);
+}
+
+Player CreatePlayerAt(int x, int y) {
+    // Player Attributes
+    SDL_Rect p_dstrect = {x, y, PLAYER_WIDTH, PLAYER_HEIGHT};
+    SDL_Rect p_srcrect = {0, 0, PLAYER_WIDTH, PLAYER_HEIGHT};
+
+    MotionState motion_state;
+    motion_state.jump = false;
+    motion_state.drop = false;
+
+    PhysicsBody body;
+    body.x = ToFixed(x);
+    body.y = ToFixed(y);
+    body.vx = 0;
+    body.vy = 0;
+    body.x_rest = 0;
+
+    CollisionState collision_state;
+    collision_state.on_the_floor = false;
+    collision_state.on_the_platform = false;
+
+    Player player;
+    player.dstrect = p_dstrect;
+    player.srcrect = p_srcrect;
+    player.speed = PLAYER_SPEED;
+    player.jump_speed = PLAYER_JUMP_SPEED;
+    player.texture = NULL;  // set by the game once the sprites are loaded
+    player.body = body;
+    player.motion_state = motion_state;
+    player.collision_state = collision_state;
+
+    return player;
+}
+
+void BuildColliders(const Level *level, SpatialHash *objects) {
+    const int cell_size = 2 * level->tilemap.tile_size;  // hash cell size
+    const int bucket_count = 2 * level->object_count;    // hash bucket count
+
+    InitSpatialHash(objects, cell_size, bucket_count);
+
+    for (int i = 0; i < level->object_count; i++) {
+        const LevelObject &object = level->objects[i];
+        const SDL_Rect rect = {object.x, object.y, object.w, object.h};
+
+        // The renderer picks the sprite of an object by its kind
+        if (object.kind == LEVEL_OBJECT_BLOCK) {
+            InsertCollider(objects, rect, COLLIDER_BLOCK, 0);
+        } else {
+            InsertCollider(objects, rect, COLLIDER_PLATFORM, 0);
+        }
+    }
+}
+
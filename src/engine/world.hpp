@@ -0,0 +1,19 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+
+#include "broadphase.hpp"
+#include "engine/entities.hpp"
+#include "level.hpp"
+
+// The player as every level starts it, at rest at the spawn. The game, the
+// benchmarks and the batch environment all start from it, so they play the
+// same player.
+Player CreatePlayer(const Level *level);
+
+// The same player at rest at any position, for levels that are generated
+Player CreatePlayerAt(int x, int y);
+
+// Objects of the level that are off the tile grid, in a spatial hash
+void BuildColliders(const Level *level, SpatialHash *objects);
+
+#endif  // WORLD_HPP
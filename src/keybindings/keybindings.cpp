@@ -1,8 +1,6 @@
 #include "keybindings.hpp"
 
-bool ClickKeybindings(SDL_Event event, MotionState *motion_state,
-                      CollisionState *collision_state, SDL_Rect *dstrect,
-                      int accel) {
+bool ClickKeybindings(SDL_Event event, Uint8 *actions) {
     bool quit = false;
     // Click Keybindings
     switch (event.type) {
@@ -15,47 +13,37 @@ bool ClickKeybindings(SDL_Event event, MotionState *motion_state,
             }
             break;
         case SDL_KEYUP:
-            if (event.key.keysym.scancode == SDL_SCANCODE_K &&
-                collision_state->on_the_floor) {
+            if (event.key.keysym.scancode == SDL_SCANCODE_K) {
                 // Player jumps
-                motion_state->jump = true;
-                collision_state->on_the_floor = false;
-                collision_state->on_the_platform = false;
-            } else if (event.key.keysym.scancode == SDL_SCANCODE_S &&
-                       collision_state->on_the_platform &&
-                       collision_state->on_the_floor) {
+                *actions |= ACTION_JUMP;
+            } else if (event.key.keysym.scancode == SDL_SCANCODE_S) {
                 // Player drops down from the platform
-                dstrect->y += accel;
-                collision_state->on_the_floor = false;
-                collision_state->on_the_platform = false;
+                *actions |= ACTION_DROP;
             }
             break;
         case SDL_CONTROLLERBUTTONDOWN:  // controller button press
             if (event.cbutton.button == SDL_CONTROLLER_BUTTON_START) {
                 quit = true;
-            } else if (event.cbutton.button == SDL_CONTROLLER_BUTTON_A &&
-                       collision_state->on_the_floor) {
+            } else if (event.cbutton.button == SDL_CONTROLLER_BUTTON_A) {
                 // Player jumps
-                motion_state->jump = true;
-                collision_state->on_the_floor = false;
-                collision_state->on_the_platform = false;
+                *actions |= ACTION_JUMP;
             } else if (event.cbutton.button ==
-                           SDL_CONTROLLER_BUTTON_DPAD_DOWN &&
-                       collision_state->on_the_platform &&
-                       collision_state->on_the_floor) {
+                       SDL_CONTROLLER_BUTTON_DPAD_DOWN) {
                 // Player drops down from the platform
-                dstrect->y += accel;
-                collision_state->on_the_floor = false;
-                collision_state->on_the_platform = false;
+                *actions |= ACTION_DROP;
             }
             break;
         default:
             break;
     }
+
+    if (quit) {
+        *actions |= ACTION_QUIT;
+    }
     return quit;
 }
 
-void HoldKeybindings(Player *player, SDL_GameController *gamecontroller) {
+Uint8 HoldKeybindings(SDL_GameController *gamecontroller) {
     /* Hold Keybindings */
     // Get the snapshot of the current state of the keyboard
     const Uint8 *state = SDL_GetKeyboardState(NULL);
@@ -64,12 +52,23 @@ void HoldKeybindings(Player *player, SDL_GameController *gamecontroller) {
         gamecontroller, SDL_CONTROLLER_BUTTON_DPAD_LEFT);
     int right_dpad = SDL_GameControllerGetButton(
         gamecontroller, SDL_CONTROLLER_BUTTON_DPAD_RIGHT);
+    int rewind_button = SDL_GameControllerGetButton(
+        gamecontroller, SDL_CONTROLLER_BUTTON_LEFTSHOULDER);
+
+    Uint8 actions = 0;
 
     if (state[SDL_SCANCODE_A] == 1 || left_dpad == 1) {
         // move player left
-        player->dstrect.x -= player->speed;
-    } else if (state[SDL_SCANCODE_D] == 1 || right_dpad == 1) {
+        actions |= ACTION_LEFT;
+    }
+    if (state[SDL_SCANCODE_D] == 1 || right_dpad == 1) {
         // move player right
-        player->dstrect.x += player->speed;
+        actions |= ACTION_RIGHT;
+    }
+    if (state[SDL_SCANCODE_R] == 1 || rewind_button == 1) {
+        // go back in time, for testing levels
+        actions |= ACTION_REWIND;
     }
+
+    return actions;
 }
@@ -1,12 +1,10 @@
 #ifndef KEYBINDINGS_HPP
 #define KEYBINDINGS_HPP
 
-#include "engine/entities.hpp"
+#include "../engine/actions.hpp"
 
-bool ClickKeybindings(SDL_Event event, MotionState *motion_state,
-                      CollisionState *collision_state, SDL_Rect *dstrect,
-                      int accel);
+bool ClickKeybindings(SDL_Event event, Uint8 *actions);
 
-void HoldKeybindings(Player *player, SDL_GameController *gamecontroller);
+Uint8 HoldKeybindings(SDL_GameController *gamecontroller);
 
 #endif  // KEYBINDINGS_HPP
@@ -1,76 +1,189 @@
-#include <array>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
+#include <vector>
 
+#include "assets/asset_loader.hpp"
+#include "assets/asset_pack.hpp"
+#include "engine/broadphase.hpp"
+#include "engine/camera.hpp"
 #include "engine/collision.hpp"
 #include "engine/entities.hpp"
-#include "engine/physics.hpp"
+#include "engine/entity_store.hpp"
+#include "engine/frame_clock.hpp"
+#include "engine/input_ring.hpp"
+#include "engine/level.hpp"
+#include "engine/profiler.hpp"
+#include "engine/render_snapshot.hpp"
+#include "engine/replay.hpp"
+#include "engine/simulation.hpp"
+#include "engine/simulation_thread.hpp"
+#include "engine/snapshot.hpp"
+#include "engine/tilemap.hpp"
+#include "engine/world.hpp"
 #include "keybindings/keybindings.hpp"
+#include "render/atlas.hpp"
+#include "render/dirty_rects.hpp"
+#include "render/profiler_overlay.hpp"
+#include "render/scene.hpp"
+#include "render/sprite_batch.hpp"
+#include "render/static_layer.hpp"
+
+constexpr int WINDOW_WIDTH = 744;   // 750
+constexpr int WINDOW_HEIGHT = 504;  // 500
+
+void FreeAndCloseResources(TextureAtlas *atlas, SDL_Texture *background_tex,
+                           StaticLayer *static_layer, Mix_Music *music,
+                           SDL_Renderer *rend, SDL_Window *win,
+                           SDL_GameController *gamecontroller);
+
+bool PollEvents(InputRing *ring, StaticLayer *static_layer);
+
+int RunHeadless(const char *level_path, long ticks, int tick_rate,
+                const char *trace_path, const InputRecording *replay,
+                InputRecording *record);
+
+int main(int argc, char *argv[]) {
+    /* Command line options */
+    bool headless = false;           // run the simulation without a window
+    long headless_ticks = 1000;      // ticks to simulate when headless
+    int tick_rate = 60;              // simulation ticks per second
+    bool show_profile = false;       // draw the frame time graph
+    bool dirty_rects = false;        // present only what moved, in software
+    const char *trace_path = NULL;   // Chrome trace written at exit
+    const char *record_path = NULL;  // actions of every tick saved at exit
+    const char *replay_path = NULL;  // actions simulated again, headless
+    const char *level_path = "assets/levels/level1.lvl";
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            headless_ticks = std::strtol(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tick_rate = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            level_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--dirty-rects") == 0) {
+            dirty_rects = true;
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            show_profile = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--headless] [--ticks N] [--tick-rate N]"
+                      << " [--level FILE] [--dirty-rects] [--profile]"
+                      << " [--trace FILE]"
+                      << " [--record FILE] [--replay FILE]" << std::endl;
+            return -1;
+        }
+    }
 
-constexpr int LEVEL_WIDTH = 744;   // 750
-constexpr int LEVEL_HEIGHT = 504;  // 500
-
-struct Coord2D {
-    int x;
-    int y;
-};
-
-void PlayerBoundary(Player *player);
+    /* Input recording */
+    InputRecording replay;
+    InputRecording record;
 
-void RenderSprites(SDL_Renderer *rend, Player player,
-                   std::array<Block, 52> blocks,
-                   std::array<Platform, 6> platforms, Background background);
+    if (replay_path != NULL) {
+        if (!LoadInputRecording(&replay, replay_path)) {
+            std::string debug_msg = "LoadInputRecording: " +
+                                    static_cast<std::string>(SDL_GetError());
+            std::cerr << debug_msg << std::endl;
+            return -1;
+        }
 
-void SetPosition(SDL_Rect *dstrect, Coord2D pos);
+        // A replay runs at the tick rate it was recorded at
+        headless = true;
+        tick_rate = replay.tick_rate;
+        headless_ticks = static_cast<long>(replay.actions.size());
+    }
 
-void FreeAndCloseResources(SDL_Surface *player_surf, SDL_Texture *player_tex,
-                           SDL_Surface *block_surf, SDL_Texture *block_tex,
-                           Mix_Music *music, SDL_Renderer *rend,
-                           SDL_Window *win, SDL_GameController *gamecontroller);
+    InitInputRecording(&record, tick_rate);
 
-void PlayerObjectCollisions(Player *player, std::array<Block, 52> blocks,
-                            std::array<Platform, 6> platforms,
-                            CollisionState *collision_state);
+    if (headless) {
+        int status = RunHeadless(level_path, headless_ticks, tick_rate,
+                                 trace_path,
+                                 replay_path != NULL ? &replay : NULL,
+                                 record_path != NULL ? &record : NULL);
 
-int main() {
-    // Player Attributes
-    const int player_width = 24;
-    const int player_height = 24;
-    const int player_speed = 2;    // speed of player
-    const int player_offset = 24;  // gap between left corner of the window
-    const int player_accel = 4;
+        if (status == 0 && record_path != NULL &&
+            !SaveInputRecording(&record, record_path)) {
+            std::string debug_msg = "SaveInputRecording: " +
+                                    static_cast<std::string>(SDL_GetError());
+            std::cerr << debug_msg << std::endl;
+            return -1;
+        }
 
-    // Block dimensions
-    const int block_width = 24;
-    const int block_height = 24;
+        return status;
+    }
 
-    const int block_source_width = 512;
-    const int block_source_height = 512;
+    // Start of the startup, for the time to the first frame
+    const Uint64 startup_start = SDL_GetPerformanceCounter();
 
-    // Platform dimensions
-    const int platform_width = 24;
-    const int platform_height = 24;
+    /* Frames per second */
+    const int default_frame_rate = 60;     // if the refresh rate is unknown
+    const size_t frame_stats_size = 4096;  // frames kept for percentiles
+    const int idle_timeout_ms = 250;       // longest wait while nothing moves
 
-    const int platform_source_width = 512;
-    const int platform_source_height = 512;
+    /* Input */
+    const size_t input_ring_size = 64;  // presses kept until a tick
 
-    // Background dimensions
-    const int background_width = LEVEL_WIDTH;
-    const int background_height = LEVEL_HEIGHT;
+    /* Rewind */
+    const int rewind_seconds = 10;  // history kept for stepping back
 
-    const int background_source_width = 1536;
-    const int background_source_height = 1024;
+    /* Profiler */
+    const size_t profile_capacity = 65536;  // phases kept in the ring
+    const int profile_frames = 120;         // frames shown in the graph
 
     /* Mixer */
     const int music_volume = MIX_MAX_VOLUME / 2;
     const int chunksize = 1024;
 
     /* Paths to the assets of the game */
+    // The cooked asset pack is used when it exists, the loose files are
+    // decoded otherwise
+    const char *pack_path = "assets/assets.pack";
     const char *player_path = "assets/player/player.png";
     const char *block_path = "assets/tiles/block.png";
     const char *music_path = "assets/music/downhill.ogg";
     const char *platform_path = "assets/tiles/platform.png";
     const char *background_path = "assets/background/background.png";
 
+    /* Load the level */
+    Level level;
+
+    if (!LoadLevel(&level, level_path)) {
+        std::string debug_msg =
+            "LoadLevel: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    /* Loads images, music, and soundeffects */
+    // Maps the pre-scaled images and the music from the asset pack
+    AssetPack pack;
+    AssetPack *assets = OpenAssetPack(&pack, pack_path) ? &pack : NULL;
+
+    // The assets are decoded on worker threads while the window, audio and
+    // renderer start up
+    AssetLoader loader;
+    InitAssetLoader(&loader, assets);
+    int player_asset = AddAsset(&loader, "player", player_path, ASSET_IMAGE);
+    int block_asset = AddAsset(&loader, "block", block_path, ASSET_IMAGE);
+    int platform_asset =
+        AddAsset(&loader, "platform", platform_path, ASSET_IMAGE);
+    int background_asset =
+        AddAsset(&loader, "background", background_path, ASSET_IMAGE);
+    int music_asset = AddAsset(&loader, "music", music_path, ASSET_MUSIC);
+    StartAssetLoader(&loader,
+                     static_cast<int>(std::thread::hardware_concurrency()));
+
     /* Initialize SDL, window, audio, and renderer */
     int sdl_status = SDL_Init(
         SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER);  // Initialize SDL library
@@ -79,6 +192,7 @@ int main() {
         std::string debug_msg =
             "SDL_Init: " + static_cast<std::string>(SDL_GetError());
         std::cerr << debug_msg << std::endl;
+        FinishAssetLoader(&loader);
         return -1;
     }
 
@@ -86,9 +200,9 @@ int main() {
         SDL_GameControllerOpen(0);  // Open Game Controller
 
     // Create window
-    SDL_Window *win =
-        SDL_CreateWindow("2D Platformer", SDL_WINDOWPOS_CENTERED,
-                         SDL_WINDOWPOS_CENTERED, LEVEL_WIDTH, LEVEL_HEIGHT, 0);
+    SDL_Window *win = SDL_CreateWindow("2D Platformer", SDL_WINDOWPOS_CENTERED,
+                                       SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH,
+                                       WINDOW_HEIGHT, 0);
 
     int open_audio_status =
         Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, 2,
@@ -98,86 +212,82 @@ int main() {
         std::string debug_msg =
             "Mix_OpenAudio: " + static_cast<std::string>(Mix_GetError());
         std::cerr << debug_msg << std::endl;
+        FinishAssetLoader(&loader);
         return -1;
     }
 
     // Creates a renderer to render the images
     // * SDL_RENDERER_SOFTWARE starts the program using the CPU hardware
     // * SDL_RENDERER_ACCELERATED starts the program using the GPU hardware
-    SDL_Renderer *rend = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED);
+    // * --dirty-rects draws in software into the window surface and only
+    //   presents the regions that changed
+    DirtyRects dirty;
+    SDL_Renderer *rend = NULL;
+
+    if (dirty_rects) {
+        rend = CreateDirtyRectRenderer(&dirty, win);
+
+        if (rend == NULL) {
+            std::string debug_msg = "CreateDirtyRectRenderer: " +
+                                    static_cast<std::string>(SDL_GetError());
+            std::cerr << debug_msg << std::endl;
+            FinishAssetLoader(&loader);
+            return -1;
+        }
+    } else {
+        rend = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED);
+    }
     SDL_SetRenderDrawColor(rend, 134, 191, 255, 255);
 
-    /* Loads images, music, and soundeffects */
-    // Creates the asset that loads the image into main memory
-    SDL_Surface *player_surf = IMG_Load(player_path);
-
-    if (player_surf == NULL) {
+    // Waits for the workers, only the uploads run on this thread
+    if (!FinishAssetLoader(&loader)) {
         std::string debug_msg =
-            "IMG_Load: " + static_cast<std::string>(IMG_GetError());
+            "FinishAssetLoader: " + static_cast<std::string>(SDL_GetError());
         std::cerr << debug_msg << std::endl;
         return -1;
     }
 
-    SDL_Surface *block_surf = IMG_Load(block_path);
+    PrintAssetTimings(&loader);
 
-    if (block_surf == NULL) {
-        std::string debug_msg =
-            "IMG_Load: " + static_cast<std::string>(IMG_GetError());
-        std::cerr << debug_msg << std::endl;
-        return -1;
-    }
+    SDL_Surface *player_surf = loader.loads[player_asset].surface;
+    SDL_Surface *block_surf = loader.loads[block_asset].surface;
+    SDL_Surface *platform_surf = loader.loads[platform_asset].surface;
+    SDL_Surface *background_surf = loader.loads[background_asset].surface;
 
-    SDL_Surface *platform_surf = IMG_Load(platform_path);
+    // The mixer has to be open to create the music
+    const AssetLoad &music_load = loader.loads[music_asset];
+    Mix_Music *music = Mix_LoadMUS_RW(
+        SDL_RWFromConstMem(music_load.data, static_cast<int>(music_load.size)),
+        1);
 
-    if (platform_surf == NULL) {
+    if (music == NULL) {
         std::string debug_msg =
-            "IMG_Load: " + static_cast<std::string>(IMG_GetError());
+            "Mix_LoadMUS_RW: " + static_cast<std::string>(Mix_GetError());
         std::cerr << debug_msg << std::endl;
         return -1;
     }
 
-    SDL_Surface *background_surf = IMG_Load(background_path);
+    // Loads images to our graphics hardware memory
+    // The player, block and platform images share one texture atlas
+    SDL_Surface *atlas_surfaces[SPRITE_COUNT] = {player_surf, block_surf,
+                                                 platform_surf};
+    TextureAtlas atlas;
 
-    if (background_surf == NULL) {
+    if (!BuildAtlas(rend, atlas_surfaces, SPRITE_COUNT, &atlas)) {
         std::string debug_msg =
-            "IMG_Load: " + static_cast<std::string>(IMG_GetError());
+            "BuildAtlas: " + static_cast<std::string>(SDL_GetError());
         std::cerr << debug_msg << std::endl;
         return -1;
     }
 
-    Mix_Music *music = Mix_LoadMUS(music_path);
-
-    if (music == NULL) {
-        std::string debug_msg =
-            "Mix_LoadMUS: " + static_cast<std::string>(Mix_GetError());
-        std::cerr << debug_msg << std::endl;
-        return -1;
-    }
+    SDL_FreeSurface(player_surf);    // Deallocate player surface
+    SDL_FreeSurface(block_surf);     // Deallocate block surface
+    SDL_FreeSurface(platform_surf);  // Deallocate platform surface
 
-    // Loads images to our graphics hardware memory
     // Player structure
-    SDL_Texture *player_tex = SDL_CreateTextureFromSurface(rend, player_surf);
-    SDL_Rect p_dstrect = {0 + player_offset,
-                          LEVEL_HEIGHT - player_height - player_offset,
-                          player_width, player_height};
-    SDL_Rect p_srcrect = {0, 0, player_width, player_height};
-
-    MotionState motion_state;
-    motion_state.jump = false;
-    motion_state.jump_frames = 0;
-
-    CollisionState collision_state;
-    collision_state.on_the_floor = false;
-    collision_state.on_the_platform = false;
-
-    Player player;
-    player.dstrect = p_dstrect;
-    player.srcrect = p_srcrect;
-    player.speed = player_speed;
-    player.texture = player_tex;
-    player.accel = player_accel;
-    player.motion_state = motion_state;
-    player.collision_state = collision_state;
+    Player player = CreatePlayer(&level);
+    player.texture = atlas.texture;
+    player.srcrect = AtlasRect(&atlas, SPRITE_PLAYER, player.srcrect);
 
     // Background structure
     SDL_Texture *background_tex =
@@ -190,196 +300,40 @@ int main() {
         return -1;
     }
 
-    SDL_Rect b_dstrect = {0, 0, background_width, background_height};
+    // The background scrolls with the level, so it is cached with the tiles
+    SDL_Rect b_dstrect = {0, 0, level.width, level.height};
 
-    SDL_Rect b_srcrect = {0, 0, background_source_width,
-                          background_source_height};
+    SDL_Rect b_srcrect = {0, 0, background_surf->w, background_surf->h};
+
+    SDL_FreeSurface(background_surf);  // Deallocate background surface
 
     Background background;
     background.dstrect = b_dstrect;
     background.srcrect = b_srcrect;
     background.texture = background_tex;
 
-    // Block structure
-    SDL_Texture *block_tex = SDL_CreateTextureFromSurface(rend, block_surf);
+    // Objects that are off the tile grid
+    SpatialHash objects;
+    BuildColliders(&level, &objects);
 
-    if (block_tex == NULL) {
-        std::string debug_msg = "SDL_CreateTextureFromSurface: " +
-                                static_cast<std::string>(SDL_GetError());
-        std::cerr << debug_msg << std::endl;
-        return -1;
-    }
+    // The camera follows the player across levels larger than the window
+    Camera camera;
+    InitCamera(&camera, WINDOW_WIDTH, WINDOW_HEIGHT, level.width,
+               level.height);
 
-    SDL_Rect w_dstrect = {LEVEL_WIDTH - 200, LEVEL_HEIGHT - 200, block_width,
-                          block_height};
+    // Blocks and platforms around the view, rebuilt when the view moves
+    // away from them
+    EntityStore sprites;
 
-    SDL_Rect w_srcrect = {0, 0, block_source_width, block_source_height};
-    Block block;
-    block.dstrect = w_dstrect;
-    block.srcrect = w_srcrect;
-    block.texture = block_tex;
+    // All tiles are submitted with a single draw call
+    SpriteBatch tile_batch;
 
-    // Platform structure
-    SDL_Texture *platform_tex =
-        SDL_CreateTextureFromSurface(rend, platform_surf);
-
-    if (platform_tex == NULL) {
-        std::string debug_msg = "SDL_CreateTextureFromSurface: " +
-                                static_cast<std::string>(SDL_GetError());
-        std::cerr << debug_msg << std::endl;
-        return -1;
-    }
-
-    SDL_Rect pl_dstrect = {LEVEL_WIDTH - 200, LEVEL_HEIGHT - 200,
-                           platform_width, platform_height};
-
-    SDL_Rect pl_srcrect = {0, 0, platform_source_width, platform_source_height};
-    Platform platform;
-    platform.dstrect = pl_dstrect;
-    platform.srcrect = pl_srcrect;
-    platform.texture = platform_tex;
-
-    // Blocks
-    std::array<Block, 52> blocks = {
-        block, block, block, block, block, block, block, block, block,
-        block, block, block, block, block, block, block, block, block,
-        block, block, block, block, block, block, block, block, block,
-        block, block, block, block, block, block, block, block, block,
-        block, block, block, block, block, block, block, block, block,
-        block, block, block, block, block, block, block,
-    };
-
-    // Platforms
-    std::array<Platform, 6> platforms = {
-        platform, platform, platform, platform, platform, platform,
-    };
-
-    /* Map layout */
-    // Set positions of the block
-    SetPosition(&blocks[0].dstrect,
-                Coord2D{LEVEL_WIDTH - 24, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[1].dstrect,
-                Coord2D{LEVEL_WIDTH - 48, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[2].dstrect,
-                Coord2D{LEVEL_WIDTH - 72, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[3].dstrect,
-                Coord2D{LEVEL_WIDTH - 96, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[4].dstrect,
-                Coord2D{LEVEL_WIDTH - 120, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[5].dstrect,
-                Coord2D{LEVEL_WIDTH - 144, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[6].dstrect,
-                Coord2D{LEVEL_WIDTH - 168, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[7].dstrect,
-                Coord2D{LEVEL_WIDTH - 192, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[8].dstrect,
-                Coord2D{LEVEL_WIDTH - 216, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[9].dstrect,
-                Coord2D{LEVEL_WIDTH - 240, LEVEL_HEIGHT - 24});
-
-    SetPosition(&blocks[10].dstrect,
-                Coord2D{LEVEL_WIDTH - 264, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[11].dstrect,
-                Coord2D{LEVEL_WIDTH - 288, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[12].dstrect,
-                Coord2D{LEVEL_WIDTH - 312, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[13].dstrect,
-                Coord2D{LEVEL_WIDTH - 336, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[14].dstrect,
-                Coord2D{LEVEL_WIDTH - 360, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[15].dstrect,
-                Coord2D{LEVEL_WIDTH - 384, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[16].dstrect,
-                Coord2D{LEVEL_WIDTH - 408, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[17].dstrect,
-                Coord2D{LEVEL_WIDTH - 432, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[18].dstrect,
-                Coord2D{LEVEL_WIDTH - 456, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[19].dstrect,
-                Coord2D{LEVEL_WIDTH - 480, LEVEL_HEIGHT - 24});
-
-    SetPosition(&blocks[20].dstrect,
-                Coord2D{LEVEL_WIDTH - 504, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[21].dstrect,
-                Coord2D{LEVEL_WIDTH - 528, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[22].dstrect,
-                Coord2D{LEVEL_WIDTH - 552, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[23].dstrect,
-                Coord2D{LEVEL_WIDTH - 576, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[24].dstrect,
-                Coord2D{LEVEL_WIDTH - 600, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[25].dstrect,
-                Coord2D{LEVEL_WIDTH - 624, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[26].dstrect,
-                Coord2D{LEVEL_WIDTH - 648, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[27].dstrect,
-                Coord2D{LEVEL_WIDTH - 672, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[28].dstrect,
-                Coord2D{LEVEL_WIDTH - 696, LEVEL_HEIGHT - 24});
-    SetPosition(&blocks[29].dstrect,
-                Coord2D{LEVEL_WIDTH - 720, LEVEL_HEIGHT - 24});
-
-    SetPosition(&blocks[30].dstrect,
-                Coord2D{LEVEL_WIDTH - 744, LEVEL_HEIGHT - 24});
-
-    SetPosition(&blocks[31].dstrect,
-                Coord2D{LEVEL_WIDTH - 360, LEVEL_HEIGHT - 216});
-    SetPosition(&blocks[32].dstrect,
-                Coord2D{LEVEL_WIDTH - 384, LEVEL_HEIGHT - 216});
-    SetPosition(&blocks[33].dstrect,
-                Coord2D{LEVEL_WIDTH - 384, LEVEL_HEIGHT - 192});
-    SetPosition(&blocks[34].dstrect,
-                Coord2D{LEVEL_WIDTH - 408, LEVEL_HEIGHT - 192});
-    SetPosition(&blocks[35].dstrect,
-                Coord2D{LEVEL_WIDTH - 408, LEVEL_HEIGHT - 168});
-    SetPosition(&blocks[36].dstrect,
-                Coord2D{LEVEL_WIDTH - 432, LEVEL_HEIGHT - 168});
-    SetPosition(&blocks[37].dstrect,
-                Coord2D{LEVEL_WIDTH - 432, LEVEL_HEIGHT - 144});
-    SetPosition(&blocks[38].dstrect,
-                Coord2D{LEVEL_WIDTH - 456, LEVEL_HEIGHT - 144});
-    SetPosition(&blocks[39].dstrect,
-                Coord2D{LEVEL_WIDTH - 456, LEVEL_HEIGHT - 120});
-    SetPosition(&blocks[40].dstrect,
-                Coord2D{LEVEL_WIDTH - 480, LEVEL_HEIGHT - 120});
-    SetPosition(&blocks[41].dstrect,
-                Coord2D{LEVEL_WIDTH - 480, LEVEL_HEIGHT - 96});
-    SetPosition(&blocks[42].dstrect,
-                Coord2D{LEVEL_WIDTH - 504, LEVEL_HEIGHT - 96});
-    SetPosition(&blocks[43].dstrect,
-                Coord2D{LEVEL_WIDTH - 504, LEVEL_HEIGHT - 72});
-    SetPosition(&blocks[44].dstrect,
-                Coord2D{LEVEL_WIDTH - 528, LEVEL_HEIGHT - 72});
-
-    // Set the positions of the platforms
-    SetPosition(&platforms[0].dstrect,
-                Coord2D{LEVEL_WIDTH - 408, LEVEL_HEIGHT - 240});
-    SetPosition(&platforms[1].dstrect,
-                Coord2D{LEVEL_WIDTH - 432, LEVEL_HEIGHT - 264});
-    SetPosition(&platforms[2].dstrect,
-                Coord2D{LEVEL_WIDTH - 456, LEVEL_HEIGHT - 288});
-    SetPosition(&platforms[3].dstrect,
-                Coord2D{LEVEL_WIDTH - 480, LEVEL_HEIGHT - 312});
-    SetPosition(&platforms[4].dstrect,
-                Coord2D{LEVEL_WIDTH - 504, LEVEL_HEIGHT - 312});
-    SetPosition(&platforms[5].dstrect,
-                Coord2D{LEVEL_WIDTH - 528, LEVEL_HEIGHT - 312});
-
-    // Set the positions of the blocks
-    SetPosition(&blocks[45].dstrect,
-                Coord2D{LEVEL_WIDTH - 432, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[46].dstrect,
-                Coord2D{LEVEL_WIDTH - 384, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[47].dstrect,
-                Coord2D{LEVEL_WIDTH - 336, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[48].dstrect,
-                Coord2D{LEVEL_WIDTH - 288, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[49].dstrect,
-                Coord2D{LEVEL_WIDTH - 240, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[50].dstrect,
-                Coord2D{LEVEL_WIDTH - 192, LEVEL_HEIGHT - 360});
-    SetPosition(&blocks[51].dstrect,
-                Coord2D{LEVEL_WIDTH - 96, LEVEL_HEIGHT - 360});
+    // Tiles are rendered once and reused while the view stays inside them
+    const int static_layer_margin = 8 * level.tilemap.tile_size;
+    StaticLayer static_layer;
+    InitStaticLayer(&static_layer, rend, WINDOW_WIDTH, WINDOW_HEIGHT,
+                    static_layer_margin, background, atlas.texture,
+                    &tile_batch);
 
     Mix_VolumeMusic(music_volume);  // Adjust music volume
 
@@ -393,298 +347,217 @@ int main() {
         return -1;
     }
 
+    /* Frame pacing */
+    // Present at the refresh rate of the display the window is on
+    SDL_DisplayMode display_mode;
+    int frame_rate = default_frame_rate;
+
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(win),
+                                  &display_mode) == 0 &&
+        display_mode.refresh_rate > 0) {
+        frame_rate = display_mode.refresh_rate;
+    }
+
+    FrameClock frame_clock;
+    InitFrameClock(&frame_clock, tick_rate, frame_rate);
+
+    FrameStats frame_stats;
+    InitFrameStats(&frame_stats, frame_stats_size);
+
+    // Time from a press reaching the SDL queue to the frame showing it
+    FrameStats input_stats;
+    InitFrameStats(&input_stats, frame_stats_size);
+
+    // Phase timers only run when the graph or a trace is wanted
+    Profiler profile;
+    Profiler *profiler = NULL;
+    ProfilerOverlay overlay;
+
+    if (show_profile || trace_path != NULL) {
+        InitProfiler(&profile, profile_capacity);
+        profiler = &profile;
+        InitProfilerOverlay(&overlay, profiler,
+                            SDL_Rect{8, 8, 2 * profile_frames, 96},
+                            profile_frames, frame_rate);
+    }
+
+    // State before each of the last ticks, to step back while testing levels
+    SnapshotRing history;
+    InitSnapshotRing(&history, rewind_seconds * tick_rate, 0);
+
+    InputRing input_ring;  // pressed actions not simulated yet
+    InitInputRing(&input_ring, input_ring_size);
+
+    /* Simulation thread */
+    // Ticks run on their own thread and only hand render snapshots to this
+    // one, which keeps the window, the events and the renderer as SDL
+    // requires
+    RenderSnapshot first_snapshot;
+    first_snapshot.previous = player.dstrect;
+    first_snapshot.current = player.dstrect;
+    first_snapshot.time = SDL_GetPerformanceCounter();
+    first_snapshot.tick = 0;
+    first_snapshot.idle = false;
+    first_snapshot.press_count = 0;
+
+    SnapshotBuffer snapshots;
+    InitSnapshotBuffer(&snapshots, &first_snapshot);
+
+    SimulationThread simulation;
+    StartSimulationThread(&simulation, &level, &objects, &player, &history,
+                          record_path != NULL ? &record : NULL, &input_ring,
+                          &snapshots, tick_rate, profiler);
+
+    const Uint64 tick_counts =
+        SDL_GetPerformanceFrequency() / static_cast<Uint64>(tick_rate);
+    Player render_player = player;     // player as it is drawn
+    std::vector<int> visible_objects;  // objects around the view
+
     /* Gameplay Loop */
-    bool quit = false;  // gameplay loop switch
+    bool quit = false;        // gameplay loop switch
+    bool first_frame = true;  // report the time to the first frame once
+
+    bool idle_shown = false;  // the idle state has been presented
+    bool waited = false;      // the last frame waited for an event
+    long idle_waits = 0;      // frames skipped to wait for an event
 
     while (!quit) {  // gameplay loop
-        /* Click Key Bindings */
-        SDL_Event event;  // Event handling
-
-        while (SDL_PollEvent(&event) == 1) {  // Events management
-            // Click Keybindings
-            quit = ClickKeybindings(event, &player.motion_state,
-                                    &player.collision_state, &player.dstrect,
-                                    player.accel);
+        if (profiler != NULL) {
+            NextProfileFrame(profiler);
         }
 
-        /* Hold Keybindings */
-        HoldKeybindings(&player, gamecontroller);
+        ProfileScope frame_scope(profiler, "Frame");
+
+        // The frame clock only paces the frames, the simulation thread
+        // runs the ticks. The time spent waiting for an event is not a
+        // frame time.
+        AdvanceFrameClock(&frame_clock, 0, waited ? NULL : &frame_stats);
+        const bool woken = waited;  // the wait for an event just ended
+        waited = false;
+
+        /* Click key bindings */
+        // The simulation thread takes the presses on its next tick
+        {
+            ProfileScope scope(profiler, "PollEvents");
+            quit = PollEvents(&input_ring, &static_layer);
+            SendHeldActions(&simulation, HoldKeybindings(gamecontroller));
+        }
 
-        /* Player boundaries */
-        PlayerBoundary(&player);
+        bool fresh = false;  // the snapshot was not drawn yet
+        const RenderSnapshot *snapshot = ReadSnapshot(&snapshots, &fresh);
+
+        /* Render on demand */
+        // Once the idle state is on the screen, wait on the event queue
+        // instead of drawing the same frame again. The graph changes every
+        // frame, so it keeps the loop drawing. After a wait, one frame is
+        // drawn to give the simulation thread time to tick the event.
+        if (snapshot->idle && idle_shown && !fresh && !woken &&
+            !static_layer.dirty && !show_profile) {
+            ProfileScope scope(profiler, "WaitForEvent");
+            WaitForEvent(&frame_clock, idle_timeout_ms);
+            waited = true;
+            idle_waits += 1;
+            continue;
+        }
 
         /* Render sprites */
-        RenderSprites(rend, player, blocks, platforms, background);
+        render_player.dstrect = SnapshotPlayerRect(
+            snapshot, SDL_GetPerformanceCounter(), tick_counts);
+        FollowCamera(&camera, render_player.dstrect);
+
+        // Only the tiles and objects around the view are submitted
+        if (MoveStaticLayer(&static_layer, camera.view)) {
+            ProfileScope scope(profiler, "BuildSprites");
+            BuildSprites(&level.tilemap, &objects, static_layer.area,
+                         &visible_objects, &sprites);
+            BuildTileBatch(&tile_batch, &atlas, &sprites, static_layer.area);
+        }
 
-        /* Gravity */
-        Gravity(&player);
+        {
+            ProfileScope scope(profiler, "Render");
+            RenderSprites(rend, render_player, &camera, &static_layer,
+                          show_profile ? &overlay : NULL,
+                          dirty_rects ? &dirty : NULL);
+        }
 
-        /* Jump physics */
-        JumpPhysics(&player, &player.motion_state);
+        idle_shown = snapshot->idle;
 
-        /* Player block collisons */
-        PlayerObjectCollisions(&player, blocks, platforms,
-                               &player.collision_state);
-    }
+        // The frame is presented, the presses of the snapshot are on screen.
+        // Presses of snapshots that were replaced before being drawn are
+        // not counted.
+        const Uint64 presented = SDL_GetPerformanceCounter();
 
-    /* Free resources and close SDL and SDL mixer */
-    FreeAndCloseResources(player_surf, player_tex, block_surf, block_tex, music,
-                          rend, win, gamecontroller);
+        for (int i = 0; fresh && i < snapshot->press_count; i++) {
+            const InputEvent &press = snapshot->presses[i];
+            AddFrameTime(&input_stats,
+                         press.queue_ms +
+                             static_cast<double>(presented - press.read_time) *
+                                 1000.0 / SDL_GetPerformanceFrequency());
+        }
 
-    return 0;
-}
+        if (first_frame) {
+            first_frame = false;
+            std::cout << "time to first frame: "
+                      << static_cast<double>(SDL_GetPerformanceCounter() -
+                                             startup_start) *
+                             1000.0 / SDL_GetPerformanceFrequency()
+                      << " ms" << std::endl;
+        }
 
-void PlayerBoundary(Player *player) {
-    /* Player boundaries */
-    // left boundary
-    if (player->dstrect.x < 0) {
-        player->dstrect.x = 0;
-    }
-    // right boundary
-    if (player->dstrect.x + player->dstrect.w > LEVEL_WIDTH) {
-        player->dstrect.x = LEVEL_WIDTH - player->dstrect.w;
-    }
-    // bottom boundary
-    if (player->dstrect.y + player->dstrect.h > LEVEL_HEIGHT) {
-        player->dstrect.y = LEVEL_HEIGHT - player->dstrect.h;
+        {
+            ProfileScope scope(profiler, "WaitForNextFrame");
+            WaitForNextFrame(&frame_clock);
+        }
     }
-    // top boundary
-    if (player->dstrect.y < 0) {
-        player->dstrect.y = 0;
+
+    // The player, history and recording belong to this thread again
+    StopSimulationThread(&simulation);
+
+    std::cout << "frame time p50: " << FrameTimePercentile(&frame_stats, 0.50)
+              << " ms, p99: " << FrameTimePercentile(&frame_stats, 0.99)
+              << " ms" << std::endl;
+    std::cout << "input latency p50: "
+              << FrameTimePercentile(&input_stats, 0.50) << " ms, p99: "
+              << FrameTimePercentile(&input_stats, 0.99)
+              << " ms, presses dropped: " << input_ring.dropped << std::endl;
+    std::cout << "frames skipped while idle: " << idle_waits << std::endl;
+
+    if (trace_path != NULL && !WriteChromeTrace(profiler, trace_path)) {
+        std::string debug_msg =
+            "WriteChromeTrace: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
     }
-}
 
-void RenderSprites(SDL_Renderer *rend, Player player,
-                   std::array<Block, 52> blocks,
-                   std::array<Platform, 6> platforms, Background background) {
-    /* Frames per second */
-    const int miliseconds = 1000;    // 1000 ms equals 1s
-    const int gameplay_frames = 60;  // amount of frames per second
-
-    /* Render sprites */
-    SDL_RenderClear(rend);
-
-    // Render background
-    SDL_RenderCopy(rend, background.texture, &background.srcrect,
-                   &background.dstrect);
-
-    // Render Blocks
-    SDL_RenderCopy(rend, blocks[0].texture, &blocks[0].srcrect,
-                   &blocks[0].dstrect);
-    SDL_RenderCopy(rend, blocks[1].texture, &blocks[1].srcrect,
-                   &blocks[1].dstrect);
-    SDL_RenderCopy(rend, blocks[2].texture, &blocks[2].srcrect,
-                   &blocks[2].dstrect);
-    SDL_RenderCopy(rend, blocks[3].texture, &blocks[3].srcrect,
-                   &blocks[3].dstrect);
-    SDL_RenderCopy(rend, blocks[4].texture, &blocks[4].srcrect,
-                   &blocks[4].dstrect);
-    SDL_RenderCopy(rend, blocks[5].texture, &blocks[5].srcrect,
-                   &blocks[5].dstrect);
-    SDL_RenderCopy(rend, blocks[6].texture, &blocks[6].srcrect,
-                   &blocks[6].dstrect);
-    SDL_RenderCopy(rend, blocks[7].texture, &blocks[7].srcrect,
-                   &blocks[7].dstrect);
-    SDL_RenderCopy(rend, blocks[8].texture, &blocks[8].srcrect,
-                   &blocks[8].dstrect);
-    SDL_RenderCopy(rend, blocks[9].texture, &blocks[9].srcrect,
-                   &blocks[9].dstrect);
-
-    SDL_RenderCopy(rend, blocks[10].texture, &blocks[10].srcrect,
-                   &blocks[10].dstrect);
-    SDL_RenderCopy(rend, blocks[11].texture, &blocks[11].srcrect,
-                   &blocks[11].dstrect);
-    SDL_RenderCopy(rend, blocks[12].texture, &blocks[12].srcrect,
-                   &blocks[12].dstrect);
-    SDL_RenderCopy(rend, blocks[13].texture, &blocks[13].srcrect,
-                   &blocks[13].dstrect);
-    SDL_RenderCopy(rend, blocks[14].texture, &blocks[14].srcrect,
-                   &blocks[14].dstrect);
-    SDL_RenderCopy(rend, blocks[15].texture, &blocks[15].srcrect,
-                   &blocks[15].dstrect);
-    SDL_RenderCopy(rend, blocks[16].texture, &blocks[16].srcrect,
-                   &blocks[16].dstrect);
-    SDL_RenderCopy(rend, blocks[17].texture, &blocks[17].srcrect,
-                   &blocks[17].dstrect);
-    SDL_RenderCopy(rend, blocks[18].texture, &blocks[18].srcrect,
-                   &blocks[18].dstrect);
-    SDL_RenderCopy(rend, blocks[19].texture, &blocks[19].srcrect,
-                   &blocks[19].dstrect);
-
-    SDL_RenderCopy(rend, blocks[20].texture, &blocks[20].srcrect,
-                   &blocks[20].dstrect);
-    SDL_RenderCopy(rend, blocks[21].texture, &blocks[21].srcrect,
-                   &blocks[21].dstrect);
-    SDL_RenderCopy(rend, blocks[22].texture, &blocks[22].srcrect,
-                   &blocks[22].dstrect);
-    SDL_RenderCopy(rend, blocks[23].texture, &blocks[23].srcrect,
-                   &blocks[23].dstrect);
-    SDL_RenderCopy(rend, blocks[24].texture, &blocks[24].srcrect,
-                   &blocks[24].dstrect);
-    SDL_RenderCopy(rend, blocks[25].texture, &blocks[25].srcrect,
-                   &blocks[25].dstrect);
-    SDL_RenderCopy(rend, blocks[26].texture, &blocks[26].srcrect,
-                   &blocks[26].dstrect);
-    SDL_RenderCopy(rend, blocks[27].texture, &blocks[27].srcrect,
-                   &blocks[27].dstrect);
-    SDL_RenderCopy(rend, blocks[28].texture, &blocks[28].srcrect,
-                   &blocks[28].dstrect);
-    SDL_RenderCopy(rend, blocks[29].texture, &blocks[29].srcrect,
-                   &blocks[29].dstrect);
-
-    SDL_RenderCopy(rend, blocks[30].texture, &blocks[30].srcrect,
-                   &blocks[30].dstrect);
-    SDL_RenderCopy(rend, blocks[31].texture, &blocks[31].srcrect,
-                   &blocks[31].dstrect);
-    SDL_RenderCopy(rend, blocks[32].texture, &blocks[32].srcrect,
-                   &blocks[32].dstrect);
-    SDL_RenderCopy(rend, blocks[33].texture, &blocks[33].srcrect,
-                   &blocks[33].dstrect);
-    SDL_RenderCopy(rend, blocks[34].texture, &blocks[34].srcrect,
-                   &blocks[34].dstrect);
-    SDL_RenderCopy(rend, blocks[35].texture, &blocks[35].srcrect,
-                   &blocks[35].dstrect);
-    SDL_RenderCopy(rend, blocks[36].texture, &blocks[36].srcrect,
-                   &blocks[36].dstrect);
-    SDL_RenderCopy(rend, blocks[37].texture, &blocks[37].srcrect,
-                   &blocks[37].dstrect);
-    SDL_RenderCopy(rend, blocks[38].texture, &blocks[38].srcrect,
-                   &blocks[38].dstrect);
-    SDL_RenderCopy(rend, blocks[39].texture, &blocks[39].srcrect,
-                   &blocks[39].dstrect);
-    SDL_RenderCopy(rend, blocks[40].texture, &blocks[40].srcrect,
-                   &blocks[40].dstrect);
-    SDL_RenderCopy(rend, blocks[41].texture, &blocks[41].srcrect,
-                   &blocks[41].dstrect);
-    SDL_RenderCopy(rend, blocks[42].texture, &blocks[42].srcrect,
-                   &blocks[42].dstrect);
-    SDL_RenderCopy(rend, blocks[43].texture, &blocks[43].srcrect,
-                   &blocks[43].dstrect);
-    SDL_RenderCopy(rend, blocks[44].texture, &blocks[44].srcrect,
-                   &blocks[44].dstrect);
-    SDL_RenderCopy(rend, blocks[45].texture, &blocks[45].srcrect,
-                   &blocks[45].dstrect);
-    SDL_RenderCopy(rend, blocks[46].texture, &blocks[46].srcrect,
-                   &blocks[46].dstrect);
-    SDL_RenderCopy(rend, blocks[47].texture, &blocks[47].srcrect,
-                   &blocks[47].dstrect);
-    SDL_RenderCopy(rend, blocks[48].texture, &blocks[48].srcrect,
-                   &blocks[48].dstrect);
-    SDL_RenderCopy(rend, blocks[49].texture, &blocks[49].srcrect,
-                   &blocks[49].dstrect);
-    SDL_RenderCopy(rend, blocks[50].texture, &blocks[50].srcrect,
-                   &blocks[50].dstrect);
-    SDL_RenderCopy(rend, blocks[51].texture, &blocks[51].srcrect,
-                   &blocks[51].dstrect);
-
-    // Render platforms
-    SDL_RenderCopy(rend, platforms[0].texture, &platforms[0].srcrect,
-                   &platforms[0].dstrect);
-    SDL_RenderCopy(rend, platforms[1].texture, &platforms[1].srcrect,
-                   &platforms[1].dstrect);
-    SDL_RenderCopy(rend, platforms[2].texture, &platforms[2].srcrect,
-                   &platforms[2].dstrect);
-    SDL_RenderCopy(rend, platforms[3].texture, &platforms[3].srcrect,
-                   &platforms[3].dstrect);
-    SDL_RenderCopy(rend, platforms[4].texture, &platforms[4].srcrect,
-                   &platforms[4].dstrect);
-    SDL_RenderCopy(rend, platforms[5].texture, &platforms[5].srcrect,
-                   &platforms[5].dstrect);
-
-    SDL_RenderCopy(rend, player.texture, &player.srcrect, &player.dstrect);
-    SDL_RenderPresent(rend);  // Triggers double buffers for multiple rendering
-    SDL_Delay(miliseconds / gameplay_frames);  // Calculates to 60 fps
-}
+    if (record_path != NULL && !SaveInputRecording(&record, record_path)) {
+        std::string debug_msg =
+            "SaveInputRecording: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+    }
 
-void SetPosition(SDL_Rect *dstrect, Coord2D pos) {
-    dstrect->x = pos.x;
-    dstrect->y = pos.y;
-}
+    /* Free resources and close SDL and SDL mixer */
+    if (dirty_rects) {
+        FreeDirtyRects(&dirty);
+    }
+    FreeAndCloseResources(&atlas, background_tex, &static_layer, music, rend,
+                          win, gamecontroller);
+    FreeAssetLoader(&loader);
+    CloseAssetPack(&pack);
+    FreeLevel(&level);
 
-void PlayerObjectCollisions(Player *player, std::array<Block, 52> blocks,
-                            std::array<Platform, 6> platforms,
-                            CollisionState *collision_state) {
-    /* Player block collisons */
-    PlayerBlockCollision(player, &blocks[0], collision_state);
-    PlayerBlockCollision(player, &blocks[1], collision_state);
-    PlayerBlockCollision(player, &blocks[2], collision_state);
-    PlayerBlockCollision(player, &blocks[3], collision_state);
-    PlayerBlockCollision(player, &blocks[4], collision_state);
-    PlayerBlockCollision(player, &blocks[5], collision_state);
-    PlayerBlockCollision(player, &blocks[6], collision_state);
-    PlayerBlockCollision(player, &blocks[7], collision_state);
-    PlayerBlockCollision(player, &blocks[8], collision_state);
-    PlayerBlockCollision(player, &blocks[9], collision_state);
-
-    PlayerBlockCollision(player, &blocks[10], collision_state);
-    PlayerBlockCollision(player, &blocks[11], collision_state);
-    PlayerBlockCollision(player, &blocks[12], collision_state);
-    PlayerBlockCollision(player, &blocks[13], collision_state);
-    PlayerBlockCollision(player, &blocks[14], collision_state);
-    PlayerBlockCollision(player, &blocks[15], collision_state);
-    PlayerBlockCollision(player, &blocks[16], collision_state);
-    PlayerBlockCollision(player, &blocks[17], collision_state);
-    PlayerBlockCollision(player, &blocks[18], collision_state);
-    PlayerBlockCollision(player, &blocks[19], collision_state);
-
-    PlayerBlockCollision(player, &blocks[20], collision_state);
-    PlayerBlockCollision(player, &blocks[21], collision_state);
-    PlayerBlockCollision(player, &blocks[22], collision_state);
-    PlayerBlockCollision(player, &blocks[23], collision_state);
-    PlayerBlockCollision(player, &blocks[24], collision_state);
-    PlayerBlockCollision(player, &blocks[25], collision_state);
-    PlayerBlockCollision(player, &blocks[26], collision_state);
-    PlayerBlockCollision(player, &blocks[27], collision_state);
-    PlayerBlockCollision(player, &blocks[28], collision_state);
-    PlayerBlockCollision(player, &blocks[29], collision_state);
-
-    PlayerBlockCollision(player, &blocks[30], collision_state);
-    PlayerBlockCollision(player, &blocks[31], collision_state);
-    PlayerBlockCollision(player, &blocks[32], collision_state);
-    PlayerBlockCollision(player, &blocks[33], collision_state);
-    PlayerBlockCollision(player, &blocks[34], collision_state);
-    PlayerBlockCollision(player, &blocks[35], collision_state);
-    PlayerBlockCollision(player, &blocks[36], collision_state);
-    PlayerBlockCollision(player, &blocks[37], collision_state);
-    PlayerBlockCollision(player, &blocks[38], collision_state);
-    PlayerBlockCollision(player, &blocks[39], collision_state);
-
-    PlayerBlockCollision(player, &blocks[40], collision_state);
-    PlayerBlockCollision(player, &blocks[41], collision_state);
-    PlayerBlockCollision(player, &blocks[42], collision_state);
-    PlayerBlockCollision(player, &blocks[43], collision_state);
-    PlayerBlockCollision(player, &blocks[44], collision_state);
-    PlayerBlockCollision(player, &blocks[45], collision_state);
-    PlayerBlockCollision(player, &blocks[46], collision_state);
-    PlayerBlockCollision(player, &blocks[47], collision_state);
-    PlayerBlockCollision(player, &blocks[48], collision_state);
-    PlayerBlockCollision(player, &blocks[49], collision_state);
-    PlayerBlockCollision(player, &blocks[50], collision_state);
-
-    PlayerBlockCollision(player, &blocks[51], collision_state);
-
-    /* Player PLatform Collisions */
-    PlayerPlatformCollision(player, &platforms[0], collision_state);
-    PlayerPlatformCollision(player, &platforms[1], collision_state);
-    PlayerPlatformCollision(player, &platforms[2], collision_state);
-    PlayerPlatformCollision(player, &platforms[3], collision_state);
-    PlayerPlatformCollision(player, &platforms[4], collision_state);
-    PlayerPlatformCollision(player, &platforms[5], collision_state);
+    return 0;
 }
 
-void FreeAndCloseResources(SDL_Surface *player_surf, SDL_Texture *player_tex,
-                           SDL_Surface *block_surf, SDL_Texture *block_tex,
-                           Mix_Music *music, SDL_Renderer *rend,
-                           SDL_Window *win,
+void FreeAndCloseResources(TextureAtlas *atlas, SDL_Texture *background_tex,
+                           StaticLayer *static_layer, Mix_Music *music,
+                           SDL_Renderer *rend, SDL_Window *win,
                            SDL_GameController *gamecontroller) {
     /* Free resources and close SDL and SDL mixer */
     Mix_FreeMusic(music);  // Free the music
 
-    // Deallocate textues and surfaces
-    SDL_FreeSurface(player_surf);    // Deallocate player and scene surfaces
-    SDL_DestroyTexture(player_tex);  // Destroy scene and player textures
-    SDL_FreeSurface(block_surf);     // Deallocate player and scene surfaces
-    SDL_DestroyTexture(block_tex);   // Destroy scene and player textures
+    // Deallocate textures
+    FreeAtlas(atlas);                    // Destroy sprite atlas texture
+    SDL_DestroyTexture(background_tex);  // Destroy background texture
+    FreeStaticLayer(static_layer);       // Destroy static layer texture
 
     // Close Game Controller
     SDL_GameControllerClose(gamecontroller);
@@ -695,3 +568,151 @@ void FreeAndCloseResources(SDL_Surface *player_surf, SDL_Texture *player_tex,
     IMG_Quit();                 // Close Image
     SDL_Quit();                 // Quit SDL subsystems
 }
+
+bool PollEvents(InputRing *ring, StaticLayer *static_layer) {
+    bool quit = false;
+
+    /* Click Key Bindings */
+    SDL_Event event;  // Event handling
+
+    while (SDL_PollEvent(&event) == 1) {  // Events management
+        // Render target contents are lost when the graphics device resets,
+        // and the window contents when the window is exposed
+        if (static_layer != NULL &&
+            (event.type == SDL_RENDER_TARGETS_RESET ||
+             event.type == SDL_RENDER_DEVICE_RESET ||
+             (event.type == SDL_WINDOWEVENT &&
+              event.window.event == SDL_WINDOWEVENT_EXPOSED))) {
+            InvalidateStaticLayer(static_layer);
+        }
+
+        // Click Keybindings, a quit stays even if more events follow it
+        Uint8 actions = 0;
+        quit |= ClickKeybindings(event, &actions);
+
+        if (actions != 0) {
+            const InputEvent press = {
+                SDL_GetPerformanceCounter(),
+                static_cast<double>(SDL_GetTicks() - event.common.timestamp),
+                actions};
+            PushInput(ring, &press);
+        }
+    }
+
+    return quit;
+}
+
+int RunHeadless(const char *level_path, long ticks, int tick_rate,
+                const char *trace_path, const InputRecording *replay,
+                InputRecording *record) {
+    /* Headless simulation */
+    // Only the event subsystem is needed so that input can still be drained
+    // without a display, audio device or renderer.
+    int sdl_status = SDL_Init(SDL_INIT_EVENTS);
+
+    if (sdl_status == -1) {
+        std::string debug_msg =
+            "SDL_Init: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    const Uint64 load_start = SDL_GetPerformanceCounter();
+
+    Level level;
+
+    if (!LoadLevel(&level, level_path)) {
+        std::string debug_msg =
+            "LoadLevel: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    SpatialHash objects;
+    BuildColliders(&level, &objects);
+
+    // Every tick is a frame of the trace
+    Profiler profile;
+    Profiler *profiler = NULL;
+
+    if (trace_path != NULL) {
+        InitProfiler(&profile, 65536);
+        profiler = &profile;
+    }
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    Player player = CreatePlayer(&level);
+
+    InputRing input_ring;
+    InitInputRing(&input_ring, 64);
+
+    long tick = 0;
+    bool quit = false;
+
+    while (!quit && tick < ticks) {  // gameplay loop without rendering
+        if (profiler != NULL) {
+            NextProfileFrame(profiler);
+        }
+
+        ProfileScope scope(profiler, "Simulate");
+        Uint8 actions = 0;
+
+        // Recorded actions replace the devices during a replay
+        if (replay != NULL) {
+            actions = replay->actions[tick];
+            quit = (actions & ACTION_QUIT) != 0;
+        } else {
+            quit = PollEvents(&input_ring, NULL);
+            InputEvent press;
+
+            while (PopInput(&input_ring, &press)) {
+                actions |= press.actions;
+            }
+            actions |= HoldKeybindings(NULL);
+        }
+
+        if (record != NULL) {
+            record->actions.push_back(actions);
+        }
+
+        SimulateTick(&player, actions, &level, &objects, tick_rate, profiler);
+        tick += 1;
+    }
+
+    const Uint64 end = SDL_GetPerformanceCounter();
+    const double frequency =
+        static_cast<double>(SDL_GetPerformanceFrequency());
+    const double seconds = static_cast<double>(end - start) / frequency;
+
+    std::cout << "level: " << level.tilemap.columns << "x"
+              << level.tilemap.rows << " tiles in "
+              << EntityCount(&level.tilemap.colliders) << " colliders, "
+              << 1000.0 * static_cast<double>(start - load_start) / frequency
+              << " ms to load" << std::endl;
+    std::cout << "ticks: " << tick << std::endl;
+    std::cout << "seconds: " << seconds << std::endl;
+    if (seconds > 0.0) {
+        std::cout << "ticks per second: " << static_cast<double>(tick) / seconds
+                  << std::endl;
+    }
+    std::cout << "player: " << player.dstrect.x << " " << player.dstrect.y
+              << std::endl;
+    std::cout << "player state hash: " << std::hex << HashPlayerState(&player)
+              << std::dec << std::endl;
+    std::cout << "broadphase queries: " << objects.stats.queries
+              << ", candidates tested: " << objects.stats.candidates
+              << ", total objects: " << objects.stats.objects << std::endl;
+
+    if (trace_path != NULL && !WriteChromeTrace(profiler, trace_path)) {
+        std::string debug_msg =
+            "WriteChromeTrace: " + static_cast<std::string>(SDL_GetError());
+        std::cerr << debug_msg << std::endl;
+        return -1;
+    }
+
+    FreeLevel(&level);
+    SDL_Quit();  // Quit SDL subsystems
+
+    return 0;
+}
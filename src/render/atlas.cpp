@@ -0,0 +1,75 @@
+#include "atlas.hpp"
+
+#include <algorithm>
+
+bool BuildAtlas(SDL_Renderer *rend, SDL_Surface *const *surfaces, int count,
+                TextureAtlas *atlas) {
+    const int max_width = 2048;  // widest shelf before starting a new one
+    const int padding = 1;       // gap that keeps filtering from bleeding
+
+    atlas->texture = NULL;
+    atlas->regions.assign(count, SDL_Rect{0, 0, 0, 0});
+
+    /* Shelf packing */
+    int shelf_x = 0;
+    int shelf_y = 0;
+    int shelf_height = 0;
+    int width = 0;
+
+    for (int i = 0; i < count; i++) {
+        const int w = surfaces[i]->w;
+        const int h = surfaces[i]->h;
+
+        if (shelf_x > 0 && shelf_x + w > max_width) {
+            shelf_x = 0;
+            shelf_y += shelf_height + padding;
+            shelf_height = 0;
+        }
+
+        atlas->regions[i] = SDL_Rect{shelf_x, shelf_y, w, h};
+        shelf_x += w + padding;
+        shelf_height = std::max(shelf_height, h);
+        width = std::max(width, shelf_x);
+    }
+
+    atlas->width = width;
+    atlas->height = shelf_y + shelf_height;
+
+    /* Copy the sprites into the atlas */
+    SDL_Surface *atlas_surf = SDL_CreateRGBSurfaceWithFormat(
+        0, atlas->width, atlas->height, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (atlas_surf == NULL) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        // Copy the alpha channel as is instead of blending it
+        SDL_Rect dstrect = atlas->regions[i];
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[i], NULL, atlas_surf, &dstrect);
+    }
+
+    atlas->texture = SDL_CreateTextureFromSurface(rend, atlas_surf);
+    SDL_FreeSurface(atlas_surf);
+
+    if (atlas->texture == NULL) {
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
+SDL_Rect AtlasRect(const TextureAtlas *atlas, int sprite, SDL_Rect source) {
+    const SDL_Rect &region = atlas->regions[sprite];
+    return SDL_Rect{region.x + source.x, region.y + source.y, source.w,
+                    source.h};
+}
+
+void FreeAtlas(TextureAtlas *atlas) {
+    SDL_DestroyTexture(atlas->texture);
+    atlas->texture = NULL;
+    atlas->regions.clear();
+}
@@ -0,0 +1,20 @@
+#ifndef ATLAS_HPP
+#define ATLAS_HPP
+
+#include <vector>
+
+typedef struct TextureAtlas {
+    SDL_Texture *texture;           // all sprites packed into one texture
+    int width;                      // width of the texture in pixels
+    int height;                     // height of the texture in pixels
+    std::vector<SDL_Rect> regions;  // area of each sprite in the texture
+} TextureAtlas;
+
+bool BuildAtlas(SDL_Renderer *rend, SDL_Surface *const *surfaces, int count,
+                TextureAtlas *atlas);
+
+SDL_Rect AtlasRect(const TextureAtlas *atlas, int sprite, SDL_Rect source);
+
+void FreeAtlas(TextureAtlas *atlas);
+
+#endif  // ATLAS_HPP
@@ -0,0 +1,97 @@
+#include "dirty_rects.hpp"
+
+SDL_Renderer *CreateDirtyRectRenderer(DirtyRects *dirty, SDL_Window *window) {
+    dirty->window = window;
+    dirty->screen = SDL_GetWindowSurface(window);
+    dirty->scene = NULL;
+    dirty->view = SDL_Rect{0, 0, 0, 0};
+    dirty->scene_valid = false;
+    dirty->full = true;
+    dirty->last.clear();
+    dirty->rects.clear();
+
+    if (dirty->screen == NULL) {
+        return NULL;
+    }
+
+    dirty->scene = SDL_CreateRGBSurfaceWithFormat(
+        0, dirty->screen->w, dirty->screen->h, 32,
+        dirty->screen->format->format);
+
+    if (dirty->scene == NULL) {
+        return NULL;
+    }
+
+    // The scene is copied over the screen as it is, never blended
+    SDL_SetSurfaceBlendMode(dirty->scene, SDL_BLENDMODE_NONE);
+
+    return SDL_CreateSoftwareRenderer(dirty->screen);
+}
+
+bool BeginDirtyFrame(DirtyRects *dirty, SDL_Renderer *rend, SDL_Rect view,
+                     bool scene_changed) {
+    dirty->full = !dirty->scene_valid || scene_changed ||
+                  view.x != dirty->view.x || view.y != dirty->view.y;
+    dirty->view = view;
+    dirty->rects.clear();
+
+    if (dirty->full) {
+        dirty->scene_valid = false;
+        return true;
+    }
+
+    /* Restore the scene under the last sprites */
+    // Draw calls are batched, so they are finished before the screen is
+    // written to directly
+    SDL_RenderFlush(rend);
+
+    for (const SDL_Rect &rect : dirty->last) {
+        SDL_Rect dstrect = rect;
+        SDL_BlitSurface(dirty->scene, &rect, dirty->screen, &dstrect);
+        dirty->rects.push_back(rect);
+    }
+
+    return false;
+}
+
+void SaveDirtyScene(DirtyRects *dirty, SDL_Renderer *rend) {
+    // The screen holds the background and tiles without any sprite yet
+    SDL_RenderFlush(rend);
+    SDL_BlendMode blend_mode;
+    SDL_GetSurfaceBlendMode(dirty->screen, &blend_mode);
+    SDL_SetSurfaceBlendMode(dirty->screen, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(dirty->screen, NULL, dirty->scene, NULL);
+    SDL_SetSurfaceBlendMode(dirty->screen, blend_mode);
+    dirty->scene_valid = true;
+}
+
+void AddDirtyRect(DirtyRects *dirty, SDL_Rect rect) {
+    const SDL_Rect screen = {0, 0, dirty->screen->w, dirty->screen->h};
+    SDL_Rect visible;
+
+    if (SDL_IntersectRect(&rect, &screen, &visible)) {
+        dirty->rects.push_back(visible);
+    }
+}
+
+void PresentDirtyRects(DirtyRects *dirty, SDL_Renderer *rend) {
+    SDL_RenderFlush(rend);
+
+    if (dirty->full) {
+        SDL_UpdateWindowSurface(dirty->window);
+    } else if (!dirty->rects.empty()) {
+        SDL_UpdateWindowSurfaceRects(dirty->window, dirty->rects.data(),
+                                     static_cast<int>(dirty->rects.size()));
+    }
+
+    // The regions restored this frame are clean again, only the ones drawn
+    // over have to be restored next frame
+    const size_t restored = dirty->full ? 0 : dirty->last.size();
+    dirty->last.assign(dirty->rects.begin() + restored, dirty->rects.end());
+}
+
+void FreeDirtyRects(DirtyRects *dirty) {
+    SDL_FreeSurface(dirty->scene);
+    dirty->scene = NULL;
+    dirty->screen = NULL;
+}
@@ -0,0 +1,36 @@
+#ifndef DIRTY_RECTS_HPP
+#define DIRTY_RECTS_HPP
+
+#include <vector>
+
+// Software rendering that presents only what changed. The renderer draws
+// straight into the window surface, and a copy of the background and tiles
+// of the view is kept without the sprites that move. Each frame the
+// regions the sprites were drawn at are restored from the copy, the sprites
+// are drawn again and only those regions are presented. Everything is
+// drawn and presented again when the view moves or the tiles change.
+typedef struct DirtyRects {
+    SDL_Window *window;           // window presented to
+    SDL_Surface *screen;          // window surface the renderer draws into
+    SDL_Surface *scene;           // background and tiles of the view
+    SDL_Rect view;                // view the scene was drawn for
+    bool scene_valid;             // the scene can be restored from
+    bool full;                    // the whole window is presented this frame
+    std::vector<SDL_Rect> last;   // regions drawn over in the last frame
+    std::vector<SDL_Rect> rects;  // regions drawn over in this frame
+} DirtyRects;
+
+SDL_Renderer *CreateDirtyRectRenderer(DirtyRects *dirty, SDL_Window *window);
+
+bool BeginDirtyFrame(DirtyRects *dirty, SDL_Renderer *rend, SDL_Rect view,
+                     bool scene_changed);
+
+void SaveDirtyScene(DirtyRects *dirty, SDL_Renderer *rend);
+
+void AddDirtyRect(DirtyRects *dirty, SDL_Rect rect);
+
+void PresentDirtyRects(DirtyRects *dirty, SDL_Renderer *rend);
+
+void FreeDirtyRects(DirtyRects *dirty);
+
+#endif  // DIRTY_RECTS_HPP
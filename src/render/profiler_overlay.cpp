@@ -0,0 +1,106 @@
+#include "profiler_overlay.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr int EVENTS_PER_FRAME = 32;  // events read back per shown frame
+
+void FillBar(SDL_Renderer *rend, SDL_Rect area, int x, int width,
+             double bottom_ms, double ms, double scale) {
+    const int bottom = static_cast<int>(bottom_ms * scale);
+    const int height = std::min(area.h - bottom, static_cast<int>(ms * scale));
+
+    if (height <= 0) {
+        return;
+    }
+
+    const SDL_Rect bar = {x, area.y + area.h - bottom - height, width, height};
+    SDL_RenderFillRect(rend, &bar);
+}
+
+}  // namespace
+
+void InitProfilerOverlay(ProfilerOverlay *overlay, Profiler *profiler,
+                         SDL_Rect area, int frame_count, int frame_rate) {
+    overlay->profiler = profiler;
+    overlay->area = area;
+    overlay->frame_rate = frame_rate;
+    overlay->events.clear();
+    overlay->frame_ms.assign(frame_count, 0.0);
+    overlay->simulate_ms.assign(frame_count, 0.0);
+    overlay->render_ms.assign(frame_count, 0.0);
+}
+
+void DrawProfilerOverlay(SDL_Renderer *rend, ProfilerOverlay *overlay) {
+    const Profiler *profiler = overlay->profiler;
+    const int frame_count = static_cast<int>(overlay->frame_ms.size());
+
+    /* Phase times of the finished frames */
+    // The current frame is still running, so the last bar is the frame
+    // before it
+    const Uint32 last_frame = profiler->frame.load();
+    std::fill(overlay->frame_ms.begin(), overlay->frame_ms.end(), 0.0);
+    std::fill(overlay->simulate_ms.begin(), overlay->simulate_ms.end(), 0.0);
+    std::fill(overlay->render_ms.begin(), overlay->render_ms.end(), 0.0);
+
+    ReadProfileEvents(profiler,
+                      static_cast<size_t>(frame_count) * EVENTS_PER_FRAME,
+                      &overlay->events);
+
+    for (const ProfileEvent &event : overlay->events) {
+        const Uint32 age = last_frame - event.frame;
+
+        if (age == 0 || age > static_cast<Uint32>(frame_count)) {
+            continue;
+        }
+
+        const int bar = frame_count - static_cast<int>(age);
+        const double ms =
+            ProfileMilliseconds(profiler, event.end - event.start);
+
+        if (std::strcmp(event.name, "Frame") == 0) {
+            overlay->frame_ms[bar] += ms;
+        } else if (std::strcmp(event.name, "Simulate") == 0) {
+            overlay->simulate_ms[bar] += ms;
+        } else if (std::strcmp(event.name, "Render") == 0) {
+            overlay->render_ms[bar] += ms;
+        }
+    }
+
+    /* Graph */
+    // The budget of a frame is half the height of the graph
+    Uint8 r, g, b, a;
+    SDL_BlendMode blend_mode;
+    SDL_GetRenderDrawColor(rend, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(rend, &blend_mode);
+    SDL_SetRenderDrawBlendMode(rend, SDL_BLENDMODE_BLEND);
+
+    const SDL_Rect area = overlay->area;
+    const double budget_ms = 1000.0 / std::max(1, overlay->frame_rate);
+    const double scale = area.h / (2.0 * budget_ms);
+    const int bar_width = std::max(1, area.w / std::max(1, frame_count));
+
+    SDL_SetRenderDrawColor(rend, 0, 0, 0, 160);
+    SDL_RenderFillRect(rend, &area);
+
+    for (int i = 0; i < frame_count; i++) {
+        const int x = area.x + i * bar_width;
+
+        SDL_SetRenderDrawColor(rend, 200, 200, 200, 200);  // waiting
+        FillBar(rend, area, x, bar_width, 0.0, overlay->frame_ms[i], scale);
+        SDL_SetRenderDrawColor(rend, 80, 220, 80, 255);  // simulation
+        FillBar(rend, area, x, bar_width, 0.0, overlay->simulate_ms[i], scale);
+        SDL_SetRenderDrawColor(rend, 80, 140, 255, 255);  // rendering
+        FillBar(rend, area, x, bar_width, overlay->simulate_ms[i],
+                overlay->render_ms[i], scale);
+    }
+
+    SDL_SetRenderDrawColor(rend, 255, 60, 60, 255);  // budget
+    const int budget_y = area.y + area.h - static_cast<int>(budget_ms * scale);
+    SDL_RenderDrawLine(rend, area.x, budget_y, area.x + area.w - 1, budget_y);
+
+    SDL_SetRenderDrawBlendMode(rend, blend_mode);
+    SDL_SetRenderDrawColor(rend, r, g, b, a);
+}
@@ -0,0 +1,25 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include <vector>
+
+#include "../engine/profiler.hpp"
+
+// Frame time graph drawn over the game, one bar per recent frame with the
+// simulation and rendering stacked at the bottom of it
+typedef struct ProfilerOverlay {
+    Profiler *profiler;                // profiler the phases come from
+    SDL_Rect area;                     // graph on the screen
+    int frame_rate;                    // frame rate the budget line is at
+    std::vector<ProfileEvent> events;  // events of the shown frames
+    std::vector<double> frame_ms;      // whole frame per bar
+    std::vector<double> simulate_ms;   // simulation ticks per bar
+    std::vector<double> render_ms;     // rendering per bar
+} ProfilerOverlay;
+
+void InitProfilerOverlay(ProfilerOverlay *overlay, Profiler *profiler,
+                         SDL_Rect area, int frame_count, int frame_rate);
+
+void DrawProfilerOverlay(SDL_Renderer *rend, ProfilerOverlay *overlay);
+
+#endif  // PROFILER_OVERLAY_HPP
@@ -0,0 +1,100 @@
+#include "scene.hpp"
+
+#include <algorithm>
+
+void BuildSprites(const TileMap *tilemap, const SpatialHash *objects,
+                  SDL_Rect area, std::vector<int> *candidates,
+                  EntityStore *sprites) {
+    const int tile_size = tilemap->tile_size;
+
+    ClearEntities(sprites);
+
+    /* Tiles inside the area */
+    const int first_column = std::max(0, area.x / tile_size);
+    const int last_column =
+        std::min(tilemap->columns - 1, (area.x + area.w - 1) / tile_size);
+    const int first_row = std::max(0, area.y / tile_size);
+    const int last_row =
+        std::min(tilemap->rows - 1, (area.y + area.h - 1) / tile_size);
+
+    for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+            const Uint8 kind = GetTile(tilemap, column, row);
+            const SDL_Rect rect = {column * tile_size, row * tile_size,
+                                   tile_size, tile_size};
+
+            if (kind == TILE_BLOCK) {
+                AddEntity(sprites, rect, COLLIDER_BLOCK, SPRITE_BLOCK);
+            } else if (kind == TILE_PLATFORM) {
+                AddEntity(sprites, rect, COLLIDER_PLATFORM, SPRITE_PLATFORM);
+            }
+        }
+    }
+
+    /* Objects off the tile grid that touch the area */
+    // Only read here, the simulation thread sweeps the same hash
+    FindCandidates(objects, area, candidates);
+
+    const EntityStore &colliders = objects->colliders;
+
+    // Objects are drawn like the tiles of their kind
+    for (int index : *candidates) {
+        const Uint8 kind = colliders.kind[index];
+        AddEntity(sprites, EntityRect(&colliders, index), kind,
+                  kind == COLLIDER_BLOCK ? SPRITE_BLOCK : SPRITE_PLATFORM);
+    }
+}
+
+void BuildTileBatch(SpriteBatch *batch, const TextureAtlas *atlas,
+                    const EntityStore *sprites, SDL_Rect area) {
+    ClearSpriteBatch(batch);
+
+    // Sprites are placed relative to the corner of the area
+    for (int i = 0; i < EntityCount(sprites); i++) {
+        const SDL_Rect dstrect = {sprites->x[i] - area.x,
+                                  sprites->y[i] - area.y, sprites->w[i],
+                                  sprites->h[i]};
+
+        AddSprite(batch, atlas->regions[sprites->sprite[i]], dstrect,
+                  atlas->width, atlas->height);
+    }
+}
+
+void RenderSprites(SDL_Renderer *rend, Player player, const Camera *camera,
+                   StaticLayer *static_layer, ProfilerOverlay *overlay,
+                   DirtyRects *dirty) {
+    SDL_Rect p_dstrect = WorldToScreen(camera, player.dstrect);
+
+    if (dirty == NULL) {
+        /* Render sprites */
+        // Render background, blocks and platforms
+        DrawStaticLayer(rend, static_layer, camera->view);
+
+        SDL_RenderCopy(rend, player.texture, &player.srcrect, &p_dstrect);
+
+        // Frame time graph on top of the game
+        if (overlay != NULL) {
+            DrawProfilerOverlay(rend, overlay);
+        }
+        SDL_RenderPresent(rend);  // Triggers double buffers
+        return;
+    }
+
+    /* Render the regions that changed */
+    // The background, blocks and platforms are only drawn when the view
+    // moved or the tiles changed, otherwise the regions the player and the
+    // graph covered are restored from the last drawing of them
+    if (BeginDirtyFrame(dirty, rend, camera->view, static_layer->dirty)) {
+        DrawStaticLayer(rend, static_layer, camera->view);
+        SaveDirtyScene(dirty, rend);
+    }
+
+    SDL_RenderCopy(rend, player.texture, &player.srcrect, &p_dstrect);
+    AddDirtyRect(dirty, p_dstrect);
+
+    if (overlay != NULL) {
+        DrawProfilerOverlay(rend, overlay);
+        AddDirtyRect(dirty, overlay->area);
+    }
+    PresentDirtyRects(dirty, rend);
+}
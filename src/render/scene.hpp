@@ -0,0 +1,34 @@
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <vector>
+
+#include "../engine/broadphase.hpp"
+#include "../engine/camera.hpp"
+#include "../engine/entity_store.hpp"
+#include "../engine/tilemap.hpp"
+#include "atlas.hpp"
+#include "dirty_rects.hpp"
+#include "engine/entities.hpp"
+#include "profiler_overlay.hpp"
+#include "sprite_batch.hpp"
+#include "static_layer.hpp"
+
+// Sprites packed into the texture atlas
+enum Sprite { SPRITE_PLAYER, SPRITE_BLOCK, SPRITE_PLATFORM, SPRITE_COUNT };
+
+// Blocks and platforms of the tiles and objects that touch the area
+void BuildSprites(const TileMap *tilemap, const SpatialHash *objects,
+                  SDL_Rect area, std::vector<int> *candidates,
+                  EntityStore *sprites);
+
+void BuildTileBatch(SpriteBatch *batch, const TextureAtlas *atlas,
+                    const EntityStore *sprites, SDL_Rect area);
+
+// Draws and presents one frame of the game, only the regions that changed
+// with dirty rectangles
+void RenderSprites(SDL_Renderer *rend, Player player, const Camera *camera,
+                   StaticLayer *static_layer, ProfilerOverlay *overlay,
+                   DirtyRects *dirty);
+
+#endif  // SCENE_HPP
@@ -0,0 +1,47 @@
+#include "sprite_batch.hpp"
+
+void ClearSpriteBatch(SpriteBatch *batch) {
+    batch->vertices.clear();
+    batch->indices.clear();
+}
+
+void AddSprite(SpriteBatch *batch, SDL_Rect srcrect, SDL_Rect dstrect,
+               int texture_width, int texture_height) {
+    const SDL_Color color = {255, 255, 255, 255};
+
+    // Texture coordinates are normalized to the size of the texture
+    const float u0 = static_cast<float>(srcrect.x) / texture_width;
+    const float v0 = static_cast<float>(srcrect.y) / texture_height;
+    const float u1 = static_cast<float>(srcrect.x + srcrect.w) / texture_width;
+    const float v1 =
+        static_cast<float>(srcrect.y + srcrect.h) / texture_height;
+
+    const float x0 = static_cast<float>(dstrect.x);
+    const float y0 = static_cast<float>(dstrect.y);
+    const float x1 = static_cast<float>(dstrect.x + dstrect.w);
+    const float y1 = static_cast<float>(dstrect.y + dstrect.h);
+
+    const int first = static_cast<int>(batch->vertices.size());
+
+    batch->vertices.push_back(SDL_Vertex{{x0, y0}, color, {u0, v0}});
+    batch->vertices.push_back(SDL_Vertex{{x1, y0}, color, {u1, v0}});
+    batch->vertices.push_back(SDL_Vertex{{x1, y1}, color, {u1, v1}});
+    batch->vertices.push_back(SDL_Vertex{{x0, y1}, color, {u0, v1}});
+
+    const int quad[6] = {0, 1, 2, 0, 2, 3};
+    for (int index : quad) {
+        batch->indices.push_back(first + index);
+    }
+}
+
+void DrawSpriteBatch(SDL_Renderer *rend, SDL_Texture *texture,
+                     const SpriteBatch *batch) {
+    if (batch->indices.empty()) {
+        return;
+    }
+
+    SDL_RenderGeometry(rend, texture, batch->vertices.data(),
+                       static_cast<int>(batch->vertices.size()),
+                       batch->indices.data(),
+                       static_cast<int>(batch->indices.size()));
+}
@@ -0,0 +1,19 @@
+#ifndef SPRITE_BATCH_HPP
+#define SPRITE_BATCH_HPP
+
+#include <vector>
+
+typedef struct SpriteBatch {
+    std::vector<SDL_Vertex> vertices;  // four corners per sprite
+    std::vector<int> indices;          // two triangles per sprite
+} SpriteBatch;
+
+void ClearSpriteBatch(SpriteBatch *batch);
+
+void AddSprite(SpriteBatch *batch, SDL_Rect srcrect, SDL_Rect dstrect,
+               int texture_width, int texture_height);
+
+void DrawSpriteBatch(SDL_Renderer *rend, SDL_Texture *texture,
+                     const SpriteBatch *batch);
+
+#endif  // SPRITE_BATCH_HPP
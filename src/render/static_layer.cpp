@@ -0,0 +1,127 @@
+#include "static_layer.hpp"
+
+#include <algorithm>
+
+namespace {
+
+bool DrawBackground(SDL_Renderer *rend, const StaticLayer *layer,
+                    SDL_Rect area) {
+    /* Part of the background under the area */
+    // The background is stretched over the level, so the area is mapped
+    // into the texture with the same scale. Returns whether it covers the
+    // whole area.
+    const Background &background = layer->background;
+    SDL_Rect visible;
+
+    if (!SDL_IntersectRect(&area, &background.dstrect, &visible)) {
+        return false;
+    }
+
+    const SDL_Rect &level = background.dstrect;
+    const SDL_Rect &image = background.srcrect;
+    SDL_Rect srcrect;
+    srcrect.x = image.x + (visible.x - level.x) * image.w / level.w;
+    srcrect.y = image.y + (visible.y - level.y) * image.h / level.h;
+    srcrect.w = std::max(1, visible.w * image.w / level.w);
+    srcrect.h = std::max(1, visible.h * image.h / level.h);
+
+    SDL_Rect dstrect = {visible.x - area.x, visible.y - area.y, visible.w,
+                        visible.h};
+    SDL_RenderCopy(rend, background.texture, &srcrect, &dstrect);
+
+    return SDL_RectEquals(&visible, &area);
+}
+
+void RenderLayer(SDL_Renderer *rend, const StaticLayer *layer,
+                 SDL_Rect area) {
+    // Only the parts of the area outside the level are left to the clear
+    if (!DrawBackground(rend, layer, area)) {
+        SDL_RenderClear(rend);
+        DrawBackground(rend, layer, area);
+    }
+
+    // Render blocks and platforms
+    DrawSpriteBatch(rend, layer->tile_tex, layer->tiles);
+}
+
+}  // namespace
+
+void InitStaticLayer(StaticLayer *layer, SDL_Renderer *rend, int view_width,
+                     int view_height, int margin, Background background,
+                     SDL_Texture *tile_tex, const SpriteBatch *tiles) {
+    layer->texture = NULL;
+    layer->width = view_width;
+    layer->height = view_height;
+    layer->area.x = 0;
+    layer->area.y = 0;
+    layer->area.w = 0;
+    layer->area.h = 0;
+    layer->dirty = true;
+    layer->background = background;
+    layer->tile_tex = tile_tex;
+    layer->tiles = tiles;
+
+    // Without render targets the tiles of the view are drawn directly every
+    // frame, and rebuilt whenever the view moves
+    if (SDL_RenderTargetSupported(rend)) {
+        layer->texture = SDL_CreateTexture(
+            rend, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+            view_width + 2 * margin, view_height + 2 * margin);
+    }
+
+    if (layer->texture != NULL) {
+        layer->width = view_width + 2 * margin;
+        layer->height = view_height + 2 * margin;
+        // The layer is opaque, copying it without blending is cheaper
+        SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_NONE);
+    }
+}
+
+bool MoveStaticLayer(StaticLayer *layer, SDL_Rect view) {
+    const SDL_Rect &area = layer->area;
+
+    if (view.x >= area.x && view.y >= area.y &&
+        view.x + view.w <= area.x + area.w &&
+        view.y + view.h <= area.y + area.h) {
+        return false;
+    }
+
+    // Center the cached area on the view, the tiles have to be rebuilt
+    layer->area.x = view.x - (layer->width - view.w) / 2;
+    layer->area.y = view.y - (layer->height - view.h) / 2;
+    layer->area.w = layer->width;
+    layer->area.h = layer->height;
+    layer->dirty = true;
+
+    return true;
+}
+
+void InvalidateStaticLayer(StaticLayer *layer) { layer->dirty = true; }
+
+void DrawStaticLayer(SDL_Renderer *rend, StaticLayer *layer, SDL_Rect view) {
+    if (layer->texture == NULL) {
+        // The area is the view itself. Nothing is cached, so drawing it
+        // is all a rebuild takes.
+        RenderLayer(rend, layer, view);
+        layer->dirty = false;
+        return;
+    }
+
+    /* Rebuild the cached layer */
+    if (layer->dirty) {
+        SDL_SetRenderTarget(rend, layer->texture);
+        RenderLayer(rend, layer, layer->area);
+        SDL_SetRenderTarget(rend, NULL);
+        layer->dirty = false;
+    }
+
+    // Render the part of the layer under the view
+    SDL_Rect srcrect = {view.x - layer->area.x, view.y - layer->area.y, view.w,
+                        view.h};
+    SDL_RenderCopy(rend, layer->texture, &srcrect, NULL);
+}
+
+void FreeStaticLayer(StaticLayer *layer) {
+    SDL_DestroyTexture(layer->texture);
+    layer->texture = NULL;
+}
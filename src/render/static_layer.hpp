@@ -0,0 +1,34 @@
+#ifndef STATIC_LAYER_HPP
+#define STATIC_LAYER_HPP
+
+#include "engine/entities.hpp"
+#include "sprite_batch.hpp"
+
+// The background, blocks and platforms never move, so the ones around the
+// view are composited once into an opaque texture that is copied to the
+// screen every frame. The texture is larger than the view and only rebuilt
+// when the view leaves it.
+typedef struct StaticLayer {
+    SDL_Texture *texture;      // cached tiles, NULL without render targets
+    int width;                 // width of the cached area in pixels
+    int height;                // height of the cached area in pixels
+    SDL_Rect area;             // level area the tiles were built for
+    bool dirty;                // the cached layer has to be rendered again
+    Background background;     // stretched over the level below the tiles
+    SDL_Texture *tile_tex;     // texture the tiles are drawn from
+    const SpriteBatch *tiles;  // tiles of the area, relative to its corner
+} StaticLayer;
+
+void InitStaticLayer(StaticLayer *layer, SDL_Renderer *rend, int view_width,
+                     int view_height, int margin, Background background,
+                     SDL_Texture *tile_tex, const SpriteBatch *tiles);
+
+bool MoveStaticLayer(StaticLayer *layer, SDL_Rect view);
+
+void InvalidateStaticLayer(StaticLayer *layer);
+
+void DrawStaticLayer(SDL_Renderer *rend, StaticLayer *layer, SDL_Rect view);
+
+void FreeStaticLayer(StaticLayer *layer);
+
+#endif  // STATIC_LAYER_HPP
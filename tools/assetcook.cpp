@@ -0,0 +1,241 @@
+/* Asset cooker
+ *
+ * Decodes and scales the assets listed in a manifest ahead of time and
+ * writes them into one pack file that the game maps at startup:
+ *   assetcook <assets.txt> <assets directory> <assets.pack>
+ */
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine/asset_pack_format.hpp"
+
+typedef struct CookedAsset {
+    PackEntry entry;         // entry written to the pack index
+    std::vector<char> data;  // pixels or file contents
+} CookedAsset;
+
+// Pixel format textures are created with on the common renderers
+constexpr Uint32 PACK_PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+bool CookImage(const std::string &path, int width, int height,
+               CookedAsset *asset);
+
+bool CookFile(const std::string &path, CookedAsset *asset);
+
+bool WritePack(const char *path, std::vector<CookedAsset> *assets);
+
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <assets.txt> <assets directory> <assets.pack>"
+                  << std::endl;
+        return -1;
+    }
+
+    std::ifstream manifest(argv[1]);
+    if (!manifest) {
+        std::cerr << "assetcook: couldn't open " << argv[1] << std::endl;
+        return -1;
+    }
+
+    const std::string directory = argv[2];
+    std::vector<CookedAsset> assets;
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(manifest, line)) {
+        line_number += 1;
+
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream words(line);
+        std::string kind;
+        std::string name;
+        std::string path;
+        words >> kind >> name >> path;
+
+        CookedAsset asset;
+        std::memset(&asset.entry, 0, sizeof(asset.entry));
+
+        bool cooked = false;
+        if (kind == "image") {
+            int width = 0;
+            int height = 0;
+            words >> width >> height;
+            cooked = !words.fail() && width > 0 && height > 0 &&
+                     CookImage(directory + "/" + path, width, height, &asset);
+        } else if (kind == "file") {
+            cooked = !words.fail() && CookFile(directory + "/" + path, &asset);
+        }
+
+        if (!cooked || name.size() >= PACK_NAME_SIZE) {
+            std::cerr << argv[1] << ":" << line_number
+                      << ": couldn't cook: " << line << std::endl;
+            return -1;
+        }
+
+        std::memcpy(asset.entry.name, name.c_str(), name.size());
+        assets.push_back(asset);
+    }
+
+    if (!WritePack(argv[3], &assets)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+bool CookImage(const std::string &path, int width, int height,
+               CookedAsset *asset) {
+    SDL_Surface *loaded = IMG_Load(path.c_str());
+    if (loaded == NULL) {
+        std::cerr << "IMG_Load: " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    SDL_Surface *source =
+        SDL_ConvertSurfaceFormat(loaded, PACK_PIXEL_FORMAT, 0);
+    SDL_FreeSurface(loaded);
+    if (source == NULL) {
+        std::cerr << "SDL_ConvertSurfaceFormat: " << SDL_GetError()
+                  << std::endl;
+        return false;
+    }
+
+    const int pitch = width * 4;
+    asset->data.assign(static_cast<size_t>(pitch) * height, 0);
+
+    /* Box filter */
+    // Every destination pixel is the alpha weighted average of the source
+    // pixels it covers, which keeps tile edges clean when shrinking 512 px
+    // images down to 24 px
+    SDL_LockSurface(source);
+    const Uint8 *pixels = static_cast<const Uint8 *>(source->pixels);
+
+    for (int y = 0; y < height; y++) {
+        const int y0 = y * source->h / height;
+        const int y1 = std::max(y0 + 1, (y + 1) * source->h / height);
+
+        for (int x = 0; x < width; x++) {
+            const int x0 = x * source->w / width;
+            const int x1 = std::max(x0 + 1, (x + 1) * source->w / width);
+
+            Uint64 sum_a = 0;
+            Uint64 sum_r = 0;
+            Uint64 sum_g = 0;
+            Uint64 sum_b = 0;
+
+            for (int sy = y0; sy < y1; sy++) {
+                const Uint32 *row = reinterpret_cast<const Uint32 *>(
+                    pixels + static_cast<size_t>(sy) * source->pitch);
+
+                for (int sx = x0; sx < x1; sx++) {
+                    const Uint32 pixel = row[sx];
+                    const Uint32 a = pixel >> 24;
+                    sum_a += a;
+                    sum_r += a * ((pixel >> 16) & 0xFF);
+                    sum_g += a * ((pixel >> 8) & 0xFF);
+                    sum_b += a * (pixel & 0xFF);
+                }
+            }
+
+            const Uint64 count = static_cast<Uint64>(y1 - y0) * (x1 - x0);
+            Uint32 pixel = static_cast<Uint32>(sum_a / count) << 24;
+            if (sum_a > 0) {
+                pixel |= static_cast<Uint32>(sum_r / sum_a) << 16;
+                pixel |= static_cast<Uint32>(sum_g / sum_a) << 8;
+                pixel |= static_cast<Uint32>(sum_b / sum_a);
+            }
+
+            std::memcpy(&asset->data[static_cast<size_t>(y) * pitch + x * 4],
+                        &pixel, sizeof(pixel));
+        }
+    }
+
+    SDL_UnlockSurface(source);
+    SDL_FreeSurface(source);
+
+    asset->entry.kind = PACK_ENTRY_IMAGE;
+    asset->entry.format = PACK_PIXEL_FORMAT;
+    asset->entry.width = width;
+    asset->entry.height = height;
+    asset->entry.pitch = pitch;
+
+    return true;
+}
+
+bool CookFile(const std::string &path, CookedAsset *asset) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "assetcook: couldn't open " << path << std::endl;
+        return false;
+    }
+
+    asset->data.assign(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+    asset->entry.kind = PACK_ENTRY_FILE;
+
+    return true;
+}
+
+bool WritePack(const char *path, std::vector<CookedAsset> *assets) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "assetcook: couldn't create " << path << std::endl;
+        return false;
+    }
+
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.entry_count = static_cast<std::uint32_t>(assets->size());
+    header.reserved = 0;
+
+    /* Layout */
+    std::uint64_t offset =
+        sizeof(PackHeader) + assets->size() * sizeof(PackEntry);
+
+    for (CookedAsset &asset : *assets) {
+        offset = (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+        asset.entry.offset = offset;
+        asset.entry.size = asset.data.size();
+        offset += asset.data.size();
+    }
+
+    /* Header, index and data */
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (const CookedAsset &asset : *assets) {
+        file.write(reinterpret_cast<const char *>(&asset.entry),
+                   sizeof(asset.entry));
+    }
+
+    for (const CookedAsset &asset : *assets) {
+        const std::uint64_t position =
+            static_cast<std::uint64_t>(file.tellp());
+        const std::vector<char> padding(asset.entry.offset - position, 0);
+        file.write(padding.data(),
+                   static_cast<std::streamsize>(padding.size()));
+        file.write(asset.data.data(),
+                   static_cast<std::streamsize>(asset.data.size()));
+    }
+
+    if (!file) {
+        std::cerr << "assetcook: couldn't write " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
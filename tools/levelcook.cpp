@@ -0,0 +1,247 @@
+/* Level cooker
+ *
+ * Converts a text level into the binary level format the game maps at
+ * startup:
+ *   levelcook <level.txt> <level.lvl>
+ *
+ * It can also generate a large synthetic level for load and collision
+ * testing:
+ *   levelcook --generate <columns> <rows> <level.lvl>
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine/level_format.hpp"
+
+typedef struct LevelSource {
+    std::int32_t tile_size;
+    std::int32_t columns;
+    std::int32_t rows;
+    std::int32_t spawn_x;
+    std::int32_t spawn_y;
+    std::vector<std::uint8_t> cells;
+    std::vector<LevelObject> objects;
+} LevelSource;
+
+// Tile kinds, these match TileKind in src/engine/tilemap.hpp
+constexpr std::uint8_t CELL_EMPTY = 0;
+constexpr std::uint8_t CELL_BLOCK = 1;
+constexpr std::uint8_t CELL_PLATFORM = 2;
+
+bool ParseLevel(const char *path, LevelSource *level);
+
+void GenerateLevel(std::int32_t columns, std::int32_t rows,
+                   LevelSource *level);
+
+bool WriteLevel(const char *path, const LevelSource &level);
+
+int main(int argc, char *argv[]) {
+    LevelSource level;
+    const char *output_path = NULL;
+
+    if (argc == 3) {
+        if (!ParseLevel(argv[1], &level)) {
+            return -1;
+        }
+        output_path = argv[2];
+    } else if (argc == 5 && std::strcmp(argv[1], "--generate") == 0) {
+        GenerateLevel(std::atoi(argv[2]), std::atoi(argv[3]), &level);
+        output_path = argv[4];
+    } else {
+        std::cerr << "Usage: " << argv[0] << " <level.txt> <level.lvl>\n"
+                  << "       " << argv[0]
+                  << " --generate <columns> <rows> <level.lvl>" << std::endl;
+        return -1;
+    }
+
+    if (!WriteLevel(output_path, level)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+bool ParseLevel(const char *path, LevelSource *level) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "levelcook: couldn't open " << path << std::endl;
+        return false;
+    }
+
+    level->tile_size = 24;
+    level->spawn_x = 0;
+    level->spawn_y = 0;
+
+    std::vector<std::string> map;
+    bool in_map = false;
+    bool has_spawn = false;
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(file, line)) {
+        line_number += 1;
+
+        if (in_map) {
+            if (line == "end") {
+                in_map = false;
+            } else {
+                map.push_back(line);
+            }
+            continue;
+        }
+
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+
+        if (keyword == "tile_size") {
+            words >> level->tile_size;
+        } else if (keyword == "map") {
+            in_map = true;
+        } else if (keyword == "block" || keyword == "platform") {
+            LevelObject object;
+            words >> object.x >> object.y >> object.w >> object.h;
+            object.kind = keyword == "block" ? LEVEL_OBJECT_BLOCK
+                                             : LEVEL_OBJECT_PLATFORM;
+            level->objects.push_back(object);
+        } else {
+            words.setstate(std::ios::failbit);
+        }
+
+        if (words.fail() || level->tile_size <= 0) {
+            std::cerr << path << ":" << line_number << ": invalid line: "
+                      << line << std::endl;
+            return false;
+        }
+    }
+
+    if (map.empty()) {
+        std::cerr << path << ": the level has no map" << std::endl;
+        return false;
+    }
+
+    /* Tile grid */
+    level->rows = static_cast<std::int32_t>(map.size());
+    level->columns = 0;
+    for (const std::string &row : map) {
+        level->columns =
+            std::max(level->columns, static_cast<std::int32_t>(row.size()));
+    }
+
+    level->cells.assign(static_cast<size_t>(level->columns) * level->rows,
+                        CELL_EMPTY);
+
+    for (std::int32_t row = 0; row < level->rows; row++) {
+        for (std::int32_t column = 0;
+             column < static_cast<std::int32_t>(map[row].size()); column++) {
+            std::uint8_t &cell =
+                level->cells[static_cast<size_t>(row) * level->columns +
+                             column];
+
+            switch (map[row][column]) {
+                case '#':
+                    cell = CELL_BLOCK;
+                    break;
+                case '=':
+                    cell = CELL_PLATFORM;
+                    break;
+                case 'P':
+                    level->spawn_x = column * level->tile_size;
+                    level->spawn_y = row * level->tile_size;
+                    has_spawn = true;
+                    break;
+                case '.':
+                    break;
+                default:
+                    std::cerr << path << ": unknown tile '" << map[row][column]
+                              << "'" << std::endl;
+                    return false;
+            }
+        }
+    }
+
+    if (!has_spawn) {
+        std::cerr << path << ": the level has no player spawn" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void GenerateLevel(std::int32_t columns, std::int32_t rows,
+                   LevelSource *level) {
+    level->tile_size = 24;
+    level->columns = std::max(columns, 4);
+    level->rows = std::max(rows, 4);
+    level->spawn_x = level->tile_size;
+    level->spawn_y = (level->rows - 2) * level->tile_size;
+
+    level->cells.assign(static_cast<size_t>(level->columns) * level->rows,
+                        CELL_EMPTY);
+
+    // Solid floor with rows of blocks and platforms at jump height
+    std::uint32_t seed = 1;
+    for (std::int32_t row = 0; row < level->rows; row++) {
+        for (std::int32_t column = 0; column < level->columns; column++) {
+            std::uint8_t &cell =
+                level->cells[static_cast<size_t>(row) * level->columns +
+                             column];
+
+            seed = seed * 1103515245U + 12345U;
+            const std::uint32_t roll = (seed >> 16) % 8;
+
+            if (row == level->rows - 1) {
+                cell = CELL_BLOCK;
+            } else if (row % 4 == 0 && roll == 0) {
+                cell = CELL_BLOCK;
+            } else if (row % 4 == 2 && roll == 1) {
+                cell = CELL_PLATFORM;
+            }
+        }
+    }
+}
+
+bool WriteLevel(const char *path, const LevelSource &level) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "levelcook: couldn't create " << path << std::endl;
+        return false;
+    }
+
+    LevelHeader header;
+    std::memcpy(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC));
+    header.version = LEVEL_VERSION;
+    header.tile_size = level.tile_size;
+    header.columns = level.columns;
+    header.rows = level.rows;
+    header.spawn_x = level.spawn_x;
+    header.spawn_y = level.spawn_y;
+    header.object_count = static_cast<std::uint32_t>(level.objects.size());
+
+    std::vector<char> cells(LevelCellsSize(level.columns, level.rows), 0);
+    std::memcpy(cells.data(), level.cells.data(), level.cells.size());
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(cells.data(), static_cast<std::streamsize>(cells.size()));
+    file.write(reinterpret_cast<const char *>(level.objects.data()),
+               static_cast<std::streamsize>(level.objects.size() *
+                                            sizeof(LevelObject)));
+
+    if (!file) {
+        std::cerr << "levelcook: couldn't write " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}